@@ -5,6 +5,4 @@ set -euo pipefail
 BASE_PATH="$(dirname "$0")/../.."
 cd "$BASE_PATH"
 
-INPUT="$1"
-shift 1
-cat "$INPUT" | build/Compiler "$@"
+build/Compiler "$@"
@@ -10,13 +10,78 @@ RED='\033[0;31m'
 OFF='\033[0m'
 STATUS=0
 
+# The status of a test whose output misses an expected line.
+MISSING_OUTPUT=255
+
+# Runs a test, and returns the status of the compiler. A test is either a file
+# (piped through the standard input), or a directory with the input files
+# (passed as arguments, in order), and optionally:
+#
+#   arguments:   the arguments instead of the files, one per line (the paths
+#                are relative to the directory of the test).
+#   generate:    a script whose output is one more input file, passed after
+#                the others (for inputs too large to keep in the repository).
+#   environment: the variables of the run, one "NAME=value" per line.
+#   output:      lines that the output (standard and error) must contain,
+#                or the test fails with the MISSING_OUTPUT status. The run
+#                logs errors, unless the environment sets LOGGING_LEVEL.
+function run() {
+	local test="$1"
+	if [ ! -d "$test" ]; then
+		cat "$test" | build/Compiler >/dev/null 2>&1
+		return "$?"
+	fi
+	local arguments=()
+	local environment=("LOGGING_LEVEL=ERROR")
+	local file
+	if [ -f "$test/arguments" ]; then
+		while IFS= read -r file; do
+			arguments+=("$test/$file")
+		done < "$test/arguments"
+	else
+		for file in $(ls "$test"); do
+			if [ "$file" != "environment" ] && [ "$file" != "generate" ] && [ "$file" != "output" ]; then
+				arguments+=("$test/$file")
+			fi
+		done
+	fi
+	local generated=""
+	if [ -f "$test/generate" ]; then
+		generated="$(mktemp)"
+		bash "$test/generate" > "$generated"
+		arguments+=("$generated")
+	fi
+	if [ -f "$test/environment" ]; then
+		mapfile -t -O 1 environment < "$test/environment"
+	fi
+	local output
+	output="$(env "${environment[@]}" build/Compiler "${arguments[@]}" 2>&1)"
+	local result="$?"
+	if [ -n "$generated" ]; then
+		rm -f "$generated"
+	fi
+	if [ -f "$test/output" ]; then
+		local line
+		while IFS= read -r line; do
+			if ! grep --quiet --fixed-strings -- "$line" <<< "$output"; then
+				echo -e "        ${RED}missing output:${OFF} $line"
+				return "$MISSING_OUTPUT"
+			fi
+		done < "$test/output"
+	fi
+	return "$result"
+}
+
 echo "Compiler should accept..."
 echo ""
 
 for test in $(ls src/test/c/accept/); do
-	cat "src/test/c/accept/$test" | build/Compiler >/dev/null 2>&1
+	run "src/test/c/accept/$test"
 	RESULT="$?"
-	if [ "$RESULT" == "0" ]; then
+	if [ "$RESULT" == "$MISSING_OUTPUT" ]; then
+		STATUS=1
+		echo -e "    $test, ${RED}but its output differs${OFF}"
+	elif [ "$RESULT" == "0" ]; then
 		echo -e "    $test, ${GREEN}and it does${OFF} (status $RESULT)"
 	else
 		STATUS=1
@@ -29,9 +94,12 @@ echo "Compiler should reject..."
 echo ""
 
 for test in $(ls src/test/c/reject/); do
-	cat "src/test/c/reject/$test" | build/Compiler >/dev/null 2>&1
+	run "src/test/c/reject/$test"
 	RESULT="$?"
-	if [ "$RESULT" != "0" ]; then
+	if [ "$RESULT" == "$MISSING_OUTPUT" ]; then
+		STATUS=1
+		echo -e "    $test, ${RED}but its output differs${OFF}"
+	elif [ "$RESULT" != "0" ]; then
 		echo -e "    $test, ${GREEN}and it does${OFF} (status $RESULT)"
 	else
 		STATUS=1
@@ -9,13 +9,17 @@
 
 @set STATUS=0
 @for /f %%f in ('dir /b !BASE_PATH!\src\test\c\accept') do @(
-	@type !BASE_PATH!\src\test\c\accept\%%f | !BASE_PATH!\build\Debug\Compiler.exe >nul 2>&1
-	@set RESULT=!ERRORLEVEL!
-	if !RESULT! equ 0 (
-		@echo     "%%f", [92mand it does[0m ^(status !RESULT!^)
+	if exist !BASE_PATH!\src\test\c\accept\%%f\* (
+		@echo     "%%f", skipped ^(a directory test: run it with script\ubuntu\test.sh^)
 	) else (
-		@set STATUS=1
-		@echo     "%%f", [91mbut it rejects[0m ^(status !RESULT!^)
+		@type !BASE_PATH!\src\test\c\accept\%%f | !BASE_PATH!\build\Debug\Compiler.exe >nul 2>&1
+		@set RESULT=!ERRORLEVEL!
+		if !RESULT! equ 0 (
+			@echo     "%%f", [92mand it does[0m ^(status !RESULT!^)
+		) else (
+			@set STATUS=1
+			@echo     "%%f", [91mbut it rejects[0m ^(status !RESULT!^)
+		)
 	)
 )
 @echo:
@@ -24,13 +28,17 @@
 @echo:
 
 @for /f %%f in ('dir /b !BASE_PATH!\src\test\c\reject') do @(
-	@type !BASE_PATH!\src\test\c\reject\%%f | !BASE_PATH!\build\Debug\Compiler.exe >nul 2>&1
-	@set RESULT=!ERRORLEVEL!
-	if !RESULT! neq 0 (
-		@echo     "%%f", [92mand it does[0m ^(status !RESULT!^)
+	if exist !BASE_PATH!\src\test\c\reject\%%f\* (
+		@echo     "%%f", skipped ^(a directory test: run it with script\ubuntu\test.sh^)
 	) else (
-		@set STATUS=1
-		@echo     "%%f", [91mbut it accepts[0m ^(status !RESULT!^)
+		@type !BASE_PATH!\src\test\c\reject\%%f | !BASE_PATH!\build\Debug\Compiler.exe >nul 2>&1
+		@set RESULT=!ERRORLEVEL!
+		if !RESULT! neq 0 (
+			@echo     "%%f", [92mand it does[0m ^(status !RESULT!^)
+		) else (
+			@set STATUS=1
+			@echo     "%%f", [91mbut it accepts[0m ^(status !RESULT!^)
+		)
 	)
 )
 
@@ -3,21 +3,62 @@
 #include "frontend/lexical-analysis/FlexActions.h"
 #include "frontend/syntactic-analysis/AbstractSyntaxTree.h"
 #include "frontend/syntactic-analysis/BisonActions.h"
+#include "frontend/syntactic-analysis/SymbolPool.h"
 #include "frontend/syntactic-analysis/SyntacticAnalyzer.h"
 #include "shared/CompilerState.h"
 #include "shared/Environment.h"
 #include "shared/Logger.h"
+#include "shared/MappedFile.h"
+#include "shared/Statistics.h"
 #include "shared/String.h"
 
 /**
- * The main entry-point of the entire application.
+ * Parses every file in the command-line arguments, and joins their
+ * definitions (in order) in a single program, so they share the symbol table
+ * and end up in the same document.
+ */
+static SyntacticAnalysisStatus _parseFiles(CompilerState * compilerState, const int count, const char ** arguments, Logger * logger) {
+	const int threads = getIntegerOrDefault("PARSING_THREADS", 1);
+	Program * program = NULL;
+	for (int k = 1; k < count; ++k) {
+		MappedFile * mappedFile = mapFile(arguments[k]);
+		if (mappedFile == NULL) {
+			logError(logger, "Cannot read the input file \"%s\".", arguments[k]);
+			return REJECT;
+		}
+		logDebugging(logger, "Parsing \"%s\"...", arguments[k]);
+		const SyntacticAnalysisStatus syntacticAnalysisStatus = parseBufferInParallel(compilerState, mappedFile->buffer, mappedFile->size, threads < 1 ? 1 : threads);
+		unmapFile(mappedFile);
+		if (syntacticAnalysisStatus != ACCEPT) {
+			logError(logger, "The syntactic-analysis phase rejects the input file \"%s\".", arguments[k]);
+			return syntacticAnalysisStatus;
+		}
+		Program * fileProgram = compilerState->abstractSyntaxtTree;
+		if (program == NULL) {
+			program = fileProgram;
+		}
+		else {
+			program->definitionSet->tail->next = fileProgram->definitionSet->first;
+			program->definitionSet->tail = fileProgram->definitionSet->tail;
+		}
+	}
+	compilerState->abstractSyntaxtTree = program;
+	return ACCEPT;
+}
+
+/**
+ * The main entry-point of the entire application. Compiles the files in the
+ * arguments (into a single document), or the standard input if there are
+ * none.
  */
 const int main(const int count, const char ** arguments) {
 	Logger * logger = createLogger("EntryPoint");
+	initializeStatisticsModule();
 	initializeFlexActionsModule();
 	initializeBisonActionsModule();
 	initializeSyntacticAnalyzerModule();
 	initializeAbstractSyntaxTreeModule();
+	initializeSymbolPoolModule();
 	initializeAutomatexModule();
 	initializeGeneratorModule();
 	
@@ -29,35 +70,50 @@ const int main(const int count, const char ** arguments) {
 	// Begin compilation process.
 	CompilerState compilerState = {
 	.abstractSyntaxtTree = NULL,
+	.arena = createArena(ARENA_BLOCK_SIZE),
+	.scanner = NULL,
 	.succeed = false,
 	.value = 0
 	};
-	const SyntacticAnalysisStatus syntacticAnalysisStatus = parse(&compilerState);
+	const SyntacticAnalysisStatus syntacticAnalysisStatus = count < 2
+		? parse(&compilerState)
+		: _parseFiles(&compilerState, count, arguments, logger);
 	CompilationStatus compilationStatus = SUCCEED;
 	if (syntacticAnalysisStatus == ACCEPT) {
 		logDebugging(logger, "Computing expression value...");
 		Program * program = compilerState.abstractSyntaxtTree;
-		ComputationResult computationResult = computeDefinitionSet(program->definitionSet);
+		const Timing computationStart = startTiming();
+		const int threads = getIntegerOrDefault("COMPUTATION_THREADS", 1);
+		ComputationResult computationResult = computeDefinitions(program->definitionSet, compilerState.arena, threads < 1 ? 1 : threads);
+		accumulatePhaseTiming(COMPUTATION_PHASE, computationStart);
 		if (computationResult.succeed) {
+			const Timing generationStart = startTiming();
 			generate(&compilerState);
+			accumulatePhaseTiming(GENERATION_PHASE, generationStart);
 		}
 		else {
 			logError(logger, "The computation phase rejects the input program.");
 			compilationStatus = FAILED;
 		}
-		logDebugging(logger, "Releasing AST resources...");
 	} else {
 		logError(logger, "The syntactic-analysis phase rejects the input program.");
 		compilationStatus = FAILED;
 	}
+
+	reportStatistics();
+
+	logDebugging(logger, "Releasing AST resources...");
+	destroyArena(compilerState.arena);
 	
 	logDebugging(logger, "Releasing modules resources...");
 	shutdownGeneratorModule();
 	shutdownAutomatexModule();
+	shutdownSymbolPoolModule();
 	shutdownAbstractSyntaxTreeModule();
 	shutdownSyntacticAnalyzerModule();
 	shutdownBisonActionsModule();
 	shutdownFlexActionsModule();
+	shutdownStatisticsModule();
 	logDebugging(logger, "Compilation is done.");
 	destroyLogger(logger);
 	return compilationStatus;
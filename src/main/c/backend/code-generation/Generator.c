@@ -4,18 +4,29 @@
 
 const char _indentationCharacter = ' ';
 const char _indentationSize = 4;
+const unsigned int _cachedIndentationLevels = 16;
 static Logger * _logger = NULL;
 
+// la salida se arma en un buffer, y la indentacion se calcula una sola vez
+static OutputBuffer * _outputBuffer = NULL;
+static char * _indentations = NULL;
+
 int automataCount = 0;
 
-TransitionMatrixCell ** transitionMatrix;
-AutomataMatrixCell ** automataMatrix;
+TransitionTable * transitionTable;
+AutomataAdjacency automataAdjacency;
 
 void initializeGeneratorModule() {
 	_logger = createLogger("Generator");
+	_outputBuffer = createOutputBuffer(stdout, OUTPUT_BUFFER_SIZE);
+	_indentations = indentation(_indentationCharacter, _cachedIndentationLevels, _indentationSize);
 }
 
 void shutdownGeneratorModule() {
+	destroyOutputBuffer(_outputBuffer);
+	_outputBuffer = NULL;
+	free(_indentations);
+	_indentations = NULL;
 	if (_logger != NULL) {
 		destroyLogger(_logger);
 	}
@@ -27,29 +38,18 @@ static void _generateEpilogue(const int value);
 static void _generateDefinitionSet(DefinitionSet * definitionSet);
 static boolean _generateDefinition(Definition * definition);
 static void _generateAutomataAndTable(Automata * automata);
-static void _generateAutomata(Automata * automata, State * states[], Symbol * symbols[], int statesCount, int symbolsCount);
-static void _generateTransitionsTable(State * states[], Symbol * symbols[], int statesCount, int symbolsCount, StateSet * finalStates);
+static void _generateAutomata(Automata * automata, State * states[], int statesCount);
+static void _generateTransitionsTable(State * states[], Symbol * symbols[], int statesCount, int symbolsCount);
 static void _generateEmptyPage();
 static void _generateProgram(Program * program);
 static void _generatePrologue(void);
-static char * _indentation(const unsigned int indentationLevel);
+static void _indentation(const unsigned int indentationLevel);
 static void _output(const unsigned int indentationLevel, const char * const format, ...);
 
-void initTransitionMatrix(int numStates, int numSymbols);
-void initAutomataMatrix(int numStates);
-void setTransitionMatrix(State * states[], Symbol * symbols[], TransitionSet * transitionSet, int statesCount, int symbolsCount);
-void setAutomataMatrix(State * states[], TransitionSet * transitionSet, int statesCount);
-int getStateIndex(char * stateValue, State * states[], int statesCount);
-int getSymbolIndex(char * symbolValue, Symbol * symbols[], int symbolsCount);
-void initializeStates(State * states[], StateSet * stateSet);
-void initializeSymbols(Symbol * symbols[], SymbolSet * symbolSet);
-int getStatesCount(StateNode * currentNode);
-int getAlphabetLength(SymbolNode * currentNode);
-boolean isFinalState(State * state, StateSet * finalStates);
-boolean stateHasTransition(Symbol stateSymbol, int numStates, int numSymbols, State * states[]);
-void freeTransitionMatrix(int numStates, int numSymbols);
-void freeAutomataMatrix(int numStates);
-void freeStatesAndSymbols(State * states[], int numStates, Symbol * symbols[], int numSymbols);
+void initAutomataAdjacency(int numStates, int numTransitions);
+void setAutomataAdjacency(TransitionSet * transitionSet, int statesCount);
+static int _compareAutomataEdges(const void * left, const void * right);
+void freeAutomataAdjacency();
 
 
 /**
@@ -79,30 +79,26 @@ static boolean _generateDefinition(Definition * definition) {
 }
 
 static void _generateAutomataAndTable(Automata * automata) {
-	int statesCount = getStatesCount(automata->states->stateSet->first);
-	int alphabetLength = getAlphabetLength(automata->alphabet->symbolSet->first);
-
-	State * states[statesCount];
-	Symbol * symbols[alphabetLength];
+	// los arreglos se arman una sola vez, al computar el automata
+	State ** states = automata->stateArray;
+	Symbol ** symbols = automata->symbolArray;
+	int statesCount = automata->stateCount;
+	int alphabetLength = automata->symbolCount;
 
-	initializeStates(states, automata->states->stateSet);
-	initializeSymbols(symbols, automata->alphabet->symbolSet);
+	transitionTable = createTransitionTable(states, statesCount, symbols, alphabetLength, automata->transitions->transitionSet);
 
-	initTransitionMatrix(statesCount, alphabetLength);
-	setTransitionMatrix(states, symbols, automata->transitions->transitionSet, statesCount, alphabetLength);
+	initAutomataAdjacency(statesCount, transitionTable->transitionsCount);
+	setAutomataAdjacency(automata->transitions->transitionSet, statesCount);
 
-	initAutomataMatrix(statesCount);
-	setAutomataMatrix(states, automata->transitions->transitionSet, statesCount);
+	_generateAutomata(automata, states, statesCount);
+	_generateTransitionsTable(states, symbols, statesCount, alphabetLength);
 
-	_generateAutomata(automata, states, symbols, statesCount, alphabetLength);
-	_generateTransitionsTable(states, symbols, statesCount, alphabetLength, automata->finals->stateSet);
-
-	freeTransitionMatrix(statesCount, alphabetLength);
-	freeAutomataMatrix(statesCount);
-	freeStatesAndSymbols(states, statesCount, symbols, alphabetLength);
+	destroyTransitionTable(transitionTable);
+	transitionTable = NULL;
+	freeAutomataAdjacency();
 }
 
-static void _generateAutomata(Automata * automata, State * states[], Symbol * symbols[], int statesCount, int symbolsCount) {
+static void _generateAutomata(Automata * automata, State * states[], int statesCount) {
 
 	// Apertura del autómata (seteo)
 	_output(0, 
@@ -122,30 +118,29 @@ static void _generateAutomata(Automata * automata, State * states[], Symbol * sy
 	Symbol initialState = automata->initials->state->symbol;
 	_output(0, "%s [style=\"initial\"];\n", initialState.value);
 
-	// Agrego todas las transiciones al automata
+	// Agrego todas las transiciones al automata (las de un mismo par de estados en una sola arista)
 	for(int i=0; i<statesCount; i++) {
-		for(int j=0; j<statesCount; j++) {
-			SymbolMatrixNode * currentNode = automataMatrix[i][j].first;
-			if(currentNode != NULL) {
-				_output(0, "%s -> %s [label=\"", states[i]->symbol.value, states[j]->symbol.value);
-				while(currentNode != NULL) {
-					if(strcmp(currentNode->symbol->value, "@") == 0) {
-						_output(0, "\\lambda");
-					} else _output(0, "%s", currentNode->symbol->value);
-					if(currentNode->next != NULL) {
-						_output(0, ", ");
-					}
- 					currentNode = currentNode->next;
+		int k = automataAdjacency.firstEdge[i];
+		while(k < automataAdjacency.firstEdge[i + 1]) {
+			int to = automataAdjacency.edges[k].to;
+			_output(0, "%s -> %s [label=\"", states[i]->symbol.value, states[to]->symbol.value);
+			while(k < automataAdjacency.firstEdge[i + 1] && automataAdjacency.edges[k].to == to) {
+				if(strcmp(automataAdjacency.edges[k].symbol->value, "@") == 0) {
+					_output(0, "\\lambda");
+				} else _output(0, "%s", automataAdjacency.edges[k].symbol->value);
+				k++;
+				if(k < automataAdjacency.firstEdge[i + 1] && automataAdjacency.edges[k].to == to) {
+					_output(0, ", ");
 				}
-				_output(0, "\"];\n");
 			}
+			_output(0, "\"];\n");
 		}
 	}
 
 	// Agrego el doble circulo a todos los estados que sean finales
 	StateNode * currentFinalNode = automata->finals->stateSet->first;
 	while( currentFinalNode != NULL ){
-		if(stateHasTransition(currentFinalNode->state->symbol, statesCount, symbolsCount, states)) {
+		if(transitionTableHasTransitions(transitionTable, transitionTableStateIndex(transitionTable, currentFinalNode->state->symbol.id))) {
 			_output(0, "%s [style=\"accepting\"];\n", currentFinalNode->state->symbol.value);
 		}
 		currentFinalNode = currentFinalNode->next;
@@ -178,7 +173,7 @@ static void _generateAutomata(Automata * automata, State * states[], Symbol * sy
 	);
 }
 
-static void _generateTransitionsTable(State * states[], Symbol * symbols[], int statesCount, int symbolsCount, StateSet * finalStates) {
+static void _generateTransitionsTable(State * states[], Symbol * symbols[], int statesCount, int symbolsCount) {
 
 	// Apertura de la tabla
 	_output(0, "%s", 
@@ -215,17 +210,19 @@ static void _generateTransitionsTable(State * states[], Symbol * symbols[], int
 		if(states[i]->isInitial) _output(0, "%s", "$\\rightarrow$");
 		if(states[i]->isFinal) _output(0, "%s", "*");
 		_output(0, "%s &", states[i]->symbol.value);
+		// la fila del estado esta ordenada por simbolo: se recorre una sola vez
+		unsigned int k = transitionTable->firstTransition[i];
+		const unsigned int rowEnd = transitionTable->firstTransition[i + 1];
 		for(int j=0; j<symbolsCount; j++) {
-			MatrixNode * currentNode = transitionMatrix[i][j].first;
-			while(currentNode != NULL) {
-				if(isFinalState(currentNode->state, finalStates)) {
-					_output(0, "*");
-				}
-				_output(0, "%s", currentNode->state->symbol.value);
-				if(currentNode->next != NULL) {
+			for(boolean first = true; k < rowEnd && transitionTable->transitionSymbols[k] == (unsigned int) j; k++, first = false) {
+				if(!first) {
 					_output(0, ", ");
 				}
-				currentNode = currentNode->next;
+				State * target = states[transitionTable->transitionTargets[k]];
+				if(transitionTableIsFinal(transitionTable, transitionTable->transitionTargets[k])) {
+					_output(0, "*");
+				}
+				_output(0, "%s", target->symbol.value);
 			}
 			if(j != symbolsCount-1){
 				_output(0, " & ");
@@ -247,194 +244,53 @@ static void _generateTransitionsTable(State * states[], Symbol * symbols[], int
 }
 
 
-void initTransitionMatrix(int numStates, int numSymbols) {
-    transitionMatrix = (TransitionMatrixCell **)malloc(numStates * sizeof(TransitionMatrixCell *));
-    for (int i = 0; i < numStates; i++) {
-        transitionMatrix[i] = (TransitionMatrixCell *)malloc(numSymbols * sizeof(TransitionMatrixCell));
-        for (int j = 0; j < numSymbols; j++) {
-            transitionMatrix[i][j].first = NULL;
-			transitionMatrix[i][j].tail = NULL;
-        }
-    }
-}
-
-void initAutomataMatrix(int numStates) {
-    automataMatrix = (AutomataMatrixCell **)malloc(numStates * sizeof(AutomataMatrixCell *));
-    for (int i = 0; i < numStates; i++) {
-        automataMatrix[i] = (AutomataMatrixCell *)malloc(numStates * sizeof(AutomataMatrixCell));
-        for (int j = 0; j < numStates; j++) {
-            automataMatrix[i][j].first = NULL;
-			automataMatrix[i][j].tail = NULL;
-        }
-    }
-}
-
-void setTransitionMatrix(State * states[], Symbol * symbols[], TransitionSet * transitionSet, int statesCount, int symbolsCount) {
-	TransitionNode * currentNode = transitionSet->first;
-	int stateIndex = 0;
-	int symbolIndex = 0;
-	while(currentNode != NULL) {
-		
-		stateIndex = getStateIndex(currentNode->transition->fromExpression->state->symbol.value, states, statesCount);
-		symbolIndex = getSymbolIndex(currentNode->transition->symbolExpression->symbol->value, symbols, symbolsCount);
-		MatrixNode * newNode = (MatrixNode *)calloc(1,sizeof(MatrixNode));
-		newNode->state=currentNode->transition->toExpression->state;
-		if(transitionMatrix[stateIndex][symbolIndex].first == NULL) {
-			transitionMatrix[stateIndex][symbolIndex].first = newNode;
-		} else {
-			transitionMatrix[stateIndex][symbolIndex].tail->next = newNode;
-		}
-		transitionMatrix[stateIndex][symbolIndex].tail = newNode;
-		currentNode = currentNode->next;
-	}
+void initAutomataAdjacency(int numStates, int numTransitions) {
+	automataAdjacency.firstEdge = (int *)calloc(numStates + 1, sizeof(int));
+	automataAdjacency.edges = (AutomataEdge *)malloc((numTransitions == 0 ? 1 : numTransitions) * sizeof(AutomataEdge));
 }
 
-void setAutomataMatrix(State * states[], TransitionSet * transitionSet, int statesCount) {
-	TransitionNode * currentNode = transitionSet->first;
-	int fromStateIndex = 0;
-	int toStateIndex = 0;
-	while(currentNode != NULL) {
-		fromStateIndex = getStateIndex(currentNode->transition->fromExpression->state->symbol.value, states, statesCount);
-        toStateIndex = getStateIndex(currentNode->transition->toExpression->state->symbol.value, states, statesCount);
-		Symbol * symbol = currentNode->transition->symbolExpression->symbol;
-        SymbolMatrixNode * newNode = (SymbolMatrixNode *)malloc(sizeof(SymbolMatrixNode));
-        newNode->symbol = symbol;
-        newNode->next = NULL;
-		if (automataMatrix[fromStateIndex][toStateIndex].first == NULL) {
-            automataMatrix[fromStateIndex][toStateIndex].first = newNode;
-        } else {
-            automataMatrix[fromStateIndex][toStateIndex].tail->next = newNode;
-        }
-        automataMatrix[fromStateIndex][toStateIndex].tail = newNode;
-        currentNode = currentNode->next;
+void setAutomataAdjacency(TransitionSet * transitionSet, int statesCount) {
+	// cuento las aristas de cada estado, y firstEdge pasa a ser el comienzo de cada uno
+	for(TransitionNode * currentNode = transitionSet->first; currentNode != NULL; currentNode = currentNode->next) {
+		automataAdjacency.firstEdge[transitionTableStateIndex(transitionTable, currentNode->transition->fromExpression->state->symbol.id) + 1]++;
 	}
-}
-
-int getStateIndex(char * stateValue, State * states[], int statesCount) {
 	for(int i=0; i<statesCount; i++) {
-		if(strcmp(stateValue, states[i]->symbol.value) == 0) {
-			return i;
-		}
-	}
-	return -1;
-}
-
-int getSymbolIndex(char * symbolValue, Symbol * symbols[], int symbolsCount) {
-	for(int i=0; i<symbolsCount; i++) {
-		if(strcmp(symbolValue, symbols[i]->value) == 0) {
-			return i;
-		}
-	}
-	return -1;
-}
-
-void initializeStates(State * states[], StateSet * stateSet) {
-    StateNode * currentStateNode = stateSet->first;
-	int numStates = 0;
-    while (currentStateNode != NULL) {
-        states[numStates++] = currentStateNode->state;
-        currentStateNode = currentStateNode->next;
-    }
-}
-
-void initializeSymbols(Symbol * symbols[], SymbolSet * symbolSet) {
-    SymbolNode * currentSymbolNode = symbolSet->first;
-	int numSymbols = 0;
-    while (currentSymbolNode != NULL) {
-        symbols[numSymbols++] = currentSymbolNode->symbol;
-        currentSymbolNode = currentSymbolNode->next;
-    }
-}
-
-int getStatesCount(StateNode * currentNode) {
-	int count = 0;
-	while(currentNode != NULL) {
-		count++;
-		currentNode = currentNode->next;
+		automataAdjacency.firstEdge[i + 1] += automataAdjacency.firstEdge[i];
 	}
-	return count;
-}
-
-int getAlphabetLength(SymbolNode * currentNode) {
-	int count = 0;
-	while(currentNode != NULL) {
-		count++;
-		currentNode = currentNode->next;
+	int * nextEdge = (int *)malloc((statesCount == 0 ? 1 : statesCount) * sizeof(int));
+	memcpy(nextEdge, automataAdjacency.firstEdge, statesCount * sizeof(int));
+	unsigned int order = 0;
+	for(TransitionNode * currentNode = transitionSet->first; currentNode != NULL; currentNode = currentNode->next) {
+		int fromStateIndex = transitionTableStateIndex(transitionTable, currentNode->transition->fromExpression->state->symbol.id);
+		AutomataEdge * edge = &automataAdjacency.edges[nextEdge[fromStateIndex]++];
+		edge->to = transitionTableStateIndex(transitionTable, currentNode->transition->toExpression->state->symbol.id);
+		edge->order = order++;
+		edge->symbol = currentNode->transition->symbolExpression->symbol;
 	}
-	return count;
-}
-
-boolean isFinalState(State * state, StateSet * finalStates) {
-	StateNode * currentFinalNode = finalStates->first;
-	while( currentFinalNode != NULL ){
-		if(strcmp(state->symbol.value, currentFinalNode->state->symbol.value) == 0) {
-			return true;
+	free(nextEdge);
+	// las aristas de cada estado, agrupadas por destino
+	for(int i=0; i<statesCount; i++) {
+		int edgesCount = automataAdjacency.firstEdge[i + 1] - automataAdjacency.firstEdge[i];
+		if(1 < edgesCount) {
+			qsort(&automataAdjacency.edges[automataAdjacency.firstEdge[i]], edgesCount, sizeof(AutomataEdge), _compareAutomataEdges);
 		}
-		currentFinalNode = currentFinalNode->next;
 	}
-	return false;
-}
-
-
-boolean stateHasTransition(Symbol stateSymbol, int numStates, int numSymbols, State * states[]) {
-	int stateIndex = getStateIndex(stateSymbol.value, states, numStates);
-
-	for (int i = 0; i < numStates; i++) {
-        for (int j = 0; j < numSymbols; j++) {
-			if(transitionMatrix[i][j].first != NULL) {
-				if(i == stateIndex) {
-					return true;
-				} else {
-					MatrixNode * currentNode = transitionMatrix[i][j].first;
-					while(currentNode != NULL) {
-						if(strcmp(currentNode->state->symbol.value, stateSymbol.value) == 0) return true;
-						currentNode = currentNode->next;
-					}
-				}
-			}
-        }
-    }
-	return false;
 }
 
-void freeTransitionMatrix(int numStates, int numSymbols) {
-    for (int i = 0; i < numStates; i++) {
-        for (int j = 0; j < numSymbols; j++) {
-            MatrixNode * currentNode = transitionMatrix[i][j].first;
-            while (currentNode != NULL) {
-                MatrixNode * temp = currentNode;
-                currentNode = currentNode->next;
-                free(temp);
-            }
-        }
-        free(transitionMatrix[i]);
-    }
-    free(transitionMatrix);
-}
-
-void freeAutomataMatrix(int numStates) {
-    for (int i = 0; i < numStates; i++) {
-        for (int j = 0; j < numStates; j++) {
-            SymbolMatrixNode * currentNode = automataMatrix[i][j].first;
-            while (currentNode != NULL) {
-                SymbolMatrixNode * temp = currentNode;
-                currentNode = currentNode->next;
-                free(temp);
-            }
-        }
-        free(automataMatrix[i]);
-    }
-    free(automataMatrix);
+static int _compareAutomataEdges(const void * left, const void * right) {
+	const AutomataEdge * leftEdge = left;
+	const AutomataEdge * rightEdge = right;
+	if(leftEdge->to != rightEdge->to) {
+		return leftEdge->to < rightEdge->to ? -1 : 1;
+	}
+	return leftEdge->order < rightEdge->order ? -1 : (leftEdge->order > rightEdge->order);
 }
 
-void freeStatesAndSymbols(State * states[], int numStates, Symbol * symbols[], int numSymbols) {
-    for (int i = 0; i < numStates; i++) {
-        free(states[i]);
-    }
-
-    for (int i = 0; i < numSymbols; i++) {
-        free(symbols[i]);
-    }
+void freeAutomataAdjacency() {
+	free(automataAdjacency.firstEdge);
+	free(automataAdjacency.edges);
+	automataAdjacency.firstEdge = NULL;
+	automataAdjacency.edges = NULL;
 }
 
 
@@ -479,23 +335,25 @@ static void _generateEpilogue(const int value) {
 }
 
 /**
- * Generates an indentation string for the specified level.
+ * Outputs the indentation for the specified level, from the cached one.
  */
-static char * _indentation(const unsigned int level) {
-	return indentation(_indentationCharacter, level, _indentationSize);
+static void _indentation(const unsigned int level) {
+	unsigned int remaining = level;
+	while (0 < remaining) {
+		const unsigned int levels = remaining < _cachedIndentationLevels ? remaining : _cachedIndentationLevels;
+		writeOutputBuffer(_outputBuffer, _indentations, levels * _indentationSize);
+		remaining -= levels;
+	}
 }
 
 /**
- * Outputs a formatted string to standard output.
+ * Outputs a formatted string to standard output, through the output buffer.
  */
 static void _output(const unsigned int indentationLevel, const char * const format, ...) {
 	va_list arguments;
 	va_start(arguments, format);
-	char * indentation = _indentation(indentationLevel);
-	char * effectiveFormat = concatenate(2, indentation, format);
-	vfprintf(stdout, effectiveFormat, arguments);
-	free(effectiveFormat);
-	free(indentation);
+	_indentation(indentationLevel);
+	printOutputBuffer(_outputBuffer, format, arguments);
 	va_end(arguments);
 }
 
@@ -506,6 +364,7 @@ void generate(CompilerState * compilerState) {
 	_generatePrologue();
 	_generateProgram(compilerState->abstractSyntaxtTree);
 	_generateEpilogue(compilerState->value);
+	flushOutputBuffer(_outputBuffer);
 	logDebugging(_logger, "Generation is done.");
 }
 
@@ -4,33 +4,34 @@
 #include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
 #include "../../shared/CompilerState.h"
 #include "../../shared/Logger.h"
+#include "../../shared/OutputBuffer.h"
+#include "../domain-specific/TransitionTable.h"
 #include "../../shared/String.h"
 #include <stdarg.h>
 #include <stdio.h>
 
-typedef struct TransitionMatrixCell TransitionMatrixCell;
-typedef struct AutomataMatrixCell AutomataMatrixCell;
-typedef struct SymbolMatrixNode SymbolMatrixNode;
-typedef struct MatrixNode MatrixNode;
+typedef struct AutomataEdge AutomataEdge;
+typedef struct AutomataAdjacency AutomataAdjacency;
 
-struct MatrixNode {
-    State * state;
-    MatrixNode * next;
-};
-
-struct TransitionMatrixCell {
-    MatrixNode * first;
-    MatrixNode * tail;
-};
-
-struct SymbolMatrixNode {
+/**
+ * A transition of the automata graph, as an edge to the index of the target
+ * state. The order is the position of the transition in its set, which keeps
+ * the labels of an edge in the original order.
+ */
+struct AutomataEdge {
+    int to;
+    unsigned int order;
     Symbol * symbol;
-    SymbolMatrixNode * next;
 };
 
-struct AutomataMatrixCell {
-    SymbolMatrixNode * first;
-    SymbolMatrixNode * tail;
+/**
+ * The edges of the automata graph in a compressed adjacency list: the edges
+ * that leave the state with index i are those in [firstEdge[i], firstEdge[i + 1]),
+ * sorted by target state.
+ */
+struct AutomataAdjacency {
+    int * firstEdge;
+    AutomataEdge * edges;
 };
 
 
@@ -2,15 +2,36 @@
 
 
 static Logger * _logger = NULL;
+static boolean _eliminateDeadDefinitions = false;
+// cada hilo que computa definiciones usa su propia arena
+static THREAD_LOCAL Arena * _arena = NULL;
+
+// los indices de los DFA viven hasta el shutdown del modulo
+static TransitionFunctionIndex ** _transitionFunctions = NULL;
+static unsigned int _transitionFunctionCount = 0;
+static unsigned int _transitionFunctionCapacity = 0;
+static Mutex _transitionFunctionsMutex = MUTEX_INITIALIZER;
+
+// cada hilo marca los elementos de las operaciones en su propio bitset, que
+// siempre queda limpio al terminar: solo se tocan los bits de los operandos
+static ThreadKey _marksKey;
 
 /*-----------------PRIVATE FUNCTIONS ---------------------------------------------*/
 
 static ComputationResult _computeFinalAndInitialStates(StateSet * set, Automata * automata);
-static ComputationResult _checkAutomataRequirements(TransitionSet * transitions, StateSet * states, SymbolSet * alphabet, AutomataType automataType);
+static ComputationResult _checkAutomataRequirements(TransitionSet * transitions, StateSet * states, SymbolSet * alphabet, Automata * automata);
 static void _filterStates( StateSet * set, StateType type);
 static ComputationResult _checkTransitionStatesAndSymbols(TransitionSet * transitions, StateSet * states, SymbolSet * alphabet);
 static ComputationResult _containsLambda(const SymbolSet * alphabet, AutomataType type);
-static ComputationResult _isDFA(TransitionSet * transitions);
+static ComputationResult _isDFA(TransitionSet * transitions, Automata * automata);
+static void _indexAutomata(StateSet * states, SymbolSet * alphabet, Automata * automata);
+static void _keepTransitionFunction(TransitionFunctionIndex * index);
+static ComputationResult _computeTimedDefinition(Definition * definition);
+static boolean _computeScheduledDefinition(Definition * definition, Arena * arena);
+static boolean _isOperation(ExpressionType type);
+static ComputationResult _computeTransitionExpression(TransitionExpression * expression, boolean isSingleElement);
+static ComputationResult _computeStateExpression(StateExpression * expression, boolean isSingleElement);
+static ComputationResult _computeSymbolExpression(SymbolExpression * expression, boolean isSingleElement);
 
 /*-----------------------------SET OPERATIONS --------------------------------------------*/
 
@@ -40,38 +61,86 @@ static void deleteRepetitionsFromTransitionSet(TransitionSet * set);
 static void deleteRepetitionsFromStateSet(StateSet * set);
 static void deleteRepetitionsFromSymbolSet(SymbolSet * set);
 
+/*---------------------------------------------- TRANSITION INDEX -----------------------------------------*/
+static TransitionIndex * _transitionIndex(TransitionSet * set);
+static void _appendIndexedTransitions(TransitionSet * set, TransitionIndex * index, boolean contained, TransitionSet * result);
+
+/*---------------------------------------------- TRANSITION PRODUCTS -----------------------------------------*/
+static TransitionSet * _singletonTransitionSet(Transition * transition, NodeType type);
+static boolean _isSingleProduct(TransitionSet * set);
+static void _productIntersection(Transition * leftProduct, Transition * rightProduct, TransitionSet * result);
+static void _expandTransitionSet(TransitionSet * set);
+static void _appendProduct(Transition * product, TransitionIndex * index, TransitionSet * result);
+static void _appendTransitionNode(TransitionSet * set, TransitionNode * node);
+
+/*---------------------------------------------- BITSETS -----------------------------------------*/
+static void _destroyMarks(void * marks);
+static Bitset * _marks(void);
+static void _markStates(StateSet * set, Bitset * marks);
+static void _clearStates(StateSet * set, Bitset * marks);
+static void _markSymbols(SymbolSet * set, Bitset * marks);
+static void _clearSymbols(SymbolSet * set, Bitset * marks);
+static void _keepMarkedStates(StateSet * set, Bitset * marks);
+static void _keepMarkedSymbols(SymbolSet * set, Bitset * marks);
+static void _appendMarkedStates(StateSet * set, Bitset * marks, StateSet * result);
+static void _appendMarkedSymbols(SymbolSet * set, Bitset * marks, SymbolSet * result);
+
 /*--------------------------------------------- INVALID OPERATORS -----------------------------------------*/
 static ComputationResult _invalidComputation();
 
 
  void initializeAutomatexModule() {
 	_logger = createLogger("Automatex");
+    initializeUtilsModule();
     initializeTable();
+    initializeDefinitionGraphModule();
+    initializeDefinitionSchedulerModule();
+    initializeExpressionCache();
+    createThreadKey(&_marksKey, _destroyMarks);
+    _eliminateDeadDefinitions = getBooleanOrDefault("ELIMINATE_DEAD_DEFINITIONS", false);
 }
 
 void shutdownAutomatexModule() {
+    for (unsigned int i = 0; i < _transitionFunctionCount; i++) {
+        destroyTransitionFunctionIndex(_transitionFunctions[i]);
+    }
+    free(_transitionFunctions);
+    _transitionFunctions = NULL;
+    _transitionFunctionCount = 0;
+    _transitionFunctionCapacity = 0;
+    shutdownExpressionCache();
+    // los hilos de trabajo liberan el suyo al terminar; falta el de este hilo
+    _destroyMarks(getThreadValue(&_marksKey));
+    deleteThreadKey(&_marksKey);
+    shutdownDefinitionSchedulerModule();
+    shutdownDefinitionGraphModule();
+    shutdownTable();
+    shutdownUtilsModule();
     if (_logger != NULL) {
 		destroyLogger(_logger);
 	}
 }
 
-ComputationResult computeDefinitionSet(DefinitionSet * definitionSet) {
+ComputationResult computeDefinitionSet(DefinitionSet * definitionSet, Arena * arena) {
     ComputationResult result = {
         .succeed = false,
         .isDefinitionSet = true
     };
+    _arena = arena;
     
     DefinitionNode * currentNode = definitionSet->first;
     while (currentNode != definitionSet->tail){
-        ComputationResult result1 = computeDefinition(currentNode->definition);
+        ComputationResult result1 = _computeTimedDefinition(currentNode->definition);
         if ( !result1.succeed ){
             logError(_logger, "There has been a problem while processing a definition");
+            _arena = NULL;
             return result;
         }
         currentNode = currentNode->next;
     }
     //para el ultimo nodo
-    ComputationResult result2 = computeDefinition(currentNode->definition);
+    ComputationResult result2 = _computeTimedDefinition(currentNode->definition);
+    _arena = NULL;
     if ( !result2.succeed ){
         logError(_logger, "There has been a problem while processing a definition");
         return result;
@@ -81,6 +150,59 @@ ComputationResult computeDefinitionSet(DefinitionSet * definitionSet) {
     return result;
 }
 
+// mide cuanto tarda cada definicion (solo si las estadisticas estan activas)
+static ComputationResult _computeTimedDefinition(Definition * definition) {
+    const Timing start = startTiming();
+    ComputationResult result = computeDefinition(definition);
+    accumulateDefinitionTiming(definitionIdentifier(definition), start);
+    return result;
+}
+
+// computa una definicion desde un hilo del scheduler, con la arena de ese hilo
+static boolean _computeScheduledDefinition(Definition * definition, Arena * arena) {
+    _arena = arena;
+    const boolean succeed = _computeTimedDefinition(definition).succeed;
+    _arena = NULL;
+    return succeed;
+}
+
+ComputationResult computeDefinitions(DefinitionSet * definitionSet, Arena * arena, const unsigned int threads) {
+    ComputationResult result = {
+        .succeed = false,
+        .isDefinitionSet = true
+    };
+    DefinitionSet * computedSet = definitionSet;
+    if ( _eliminateDeadDefinitions ){
+        // las definiciones que ningun automata usa no se computan
+        computedSet = liveDefinitionSet(definitionSet, arena);
+        if ( computedSet == NULL )
+            return result;
+    }
+    if ( computedSet->first == NULL ){
+        result.succeed = true;
+    }
+    else if ( threads < 2 ){
+        result = computeDefinitionSet(computedSet, arena);
+    }
+    else {
+        const int failure = scheduleDefinitions(computedSet, arena, threads, _computeScheduledDefinition);
+        if ( 0 <= failure ){
+            DefinitionNode * failedNode = computedSet->first;
+            for (int k = 0; k < failure; k++)
+                failedNode = failedNode->next;
+            logError(_logger, "There has been a problem while processing the definition %s", definitionIdentifier(failedNode->definition));
+            clearExpressionCache();
+            return result;
+        }
+        result.succeed = true;
+    }
+    // los sets cacheados son de esta compilacion
+    clearExpressionCache();
+    if ( result.succeed )
+        result.definitionSet = definitionSet;
+    return result;
+}
+
 ComputationResult computeDefinition(Definition * definition) {
     ComputationResult result = {
         .isDefinitionSet = true,
@@ -185,12 +307,21 @@ ComputationResult computeAutomata(Automata * automata) {
     if ( !transitionSetResult.succeed ){
         return transitionSetResult;   
     }
+    _expandTransitionSet(transitionSetResult.transitionSet);
     logInformation(_logger,"-----computed transitions-----");
-    result = _checkAutomataRequirements(transitionSetResult.transitionSet, stateSetResult.stateSet, symbolSetResult.symbolSet, automata->automataType);
+    result = _checkAutomataRequirements(transitionSetResult.transitionSet, stateSetResult.stateSet, symbolSetResult.symbolSet, automata);
     if ( !result.succeed ){
         return result;   
     }
     logInformation(_logger,"-----checked transitions-----");
+    // un campo con una operacion guarda sus operandos: se reemplaza por el conjunto computado
+    automata->states->stateSet = stateSetResult.stateSet;
+    automata->states->type = SET_EXPRESSION;
+    automata->alphabet->symbolSet = symbolSetResult.symbolSet;
+    automata->alphabet->type = SET_EXPRESSION;
+    automata->transitions->transitionSet = transitionSetResult.transitionSet;
+    automata->transitions->type = SET_EXPRESSION;
+    _indexAutomata(stateSetResult.stateSet, symbolSetResult.symbolSet, automata);
     result.type = AUTOMATA_DEFINITION,
     
     result.automata = automata;
@@ -204,12 +335,13 @@ static ComputationResult _computeFinalAndInitialStates(StateSet * set, Automata
     State * currentState;
     StateNode * finalTail =NULL;
     State * initialState = NULL; 
-    StateSet * finalSet = calloc(1, sizeof(StateSet));
+    StateSet * finalSet = allocateFromArena(_arena, sizeof(StateSet));
     while ( currentNode != NULL){
         currentState =  currentNode->state;
         if ( currentState->isFinal ) {
-            StateNode * node = calloc(1,sizeof(StateNode));
+            StateNode * node = allocateFromArena(_arena, sizeof(StateNode));
             node->state = currentNode->state;
+            node->type = ELEMENT;
             if ( finalSet->first==NULL )
                 finalSet->first = node;
             else 
@@ -235,9 +367,9 @@ static ComputationResult _computeFinalAndInitialStates(StateSet * set, Automata
         return _invalidComputation();
     }
 
-    automata->initials = calloc(1,sizeof(StateExpression));
+    automata->initials = allocateFromArena(_arena, sizeof(StateExpression));
     automata->initials->state = initialState;
-    automata->finals = calloc(1,sizeof(StateExpression));
+    automata->finals = allocateFromArena(_arena, sizeof(StateExpression));
     finalSet->tail = finalTail;
     automata->finals->stateSet = finalSet; 
     ComputationResult result = { .succeed = true };
@@ -246,16 +378,18 @@ static ComputationResult _computeFinalAndInitialStates(StateSet * set, Automata
     return result; 
 }
 
-static ComputationResult _checkAutomataRequirements(TransitionSet * transitions, StateSet * states, SymbolSet * alphabet, AutomataType automataType) {
+static ComputationResult _checkAutomataRequirements(TransitionSet * transitions, StateSet * states, SymbolSet * alphabet, Automata * automata) {
+    AutomataType automataType = automata->automataType;
     logInformation(_logger, "checking automata requirements");
     ComputationResult result;
     
     if ( automataType==LNFA_AUTOMATA ) {
         // agrego lambda al alphabet
-        Symbol * lambda = calloc(1,sizeof(Symbol));
-        lambda->value = LAMBDA_STRING; 
-        SymbolNode * node = calloc(1,sizeof(SymbolNode));
+        Symbol * lambda = internSymbol(LAMBDA_STRING);
+        SymbolNode * node = allocateFromArena(_arena, sizeof(SymbolNode));
         node->symbol = lambda;
+        node->type = ELEMENT;
+        ownSymbolSet(alphabet, _arena);
         alphabet->tail->next = node;
         alphabet->tail = node;
         if ( alphabet->first == NULL)
@@ -271,49 +405,73 @@ static ComputationResult _checkAutomataRequirements(TransitionSet * transitions,
         return result;
 
     if ( automataType==DFA_AUTOMATA)
-        return _isDFA(transitions);
+        return _isDFA(transitions, automata);
     return result;
     
 }
 
-static ComputationResult _isDFA(TransitionSet * transitions) {
+/* Una sola pasada con el indice (from, simbolo) -> transicion, informando todos los conflictos */
+static ComputationResult _isDFA(TransitionSet * transitions, Automata * automata) {
+    TransitionFunctionIndex * index = createTransitionFunctionIndex();
     TransitionNode * currentNode = transitions->first;
-    TransitionNode * otherNode;
-    State * fromState, * toState;
-    Symbol * symbol;
-    Transition * transition;
+    Transition * transition, * defined;
+    boolean isDeterministic = true;
     while ( currentNode != NULL ){
-        transition= currentNode->transition;
-        fromState = transition->fromExpression->state;
-        toState = transition->toExpression->state;
-        symbol = transition->symbolExpression->symbol;
-        otherNode = currentNode ->next;
-        while ( otherNode!= NULL ){
-            transition = otherNode->transition;
-            if ( stateSymbolEquals(transition->fromExpression->state,fromState) && symbolEquals(transition->symbolExpression->symbol, symbol) 
-                && !stateSymbolEquals(transition->toExpression->state,toState) ){    // ! tal vez se pueda sacar si no se sacaron los repetidos
+        transition = currentNode->transition;
+        defined = putTransitionFunction(index, transition);
+        if ( !stateSymbolEquals(defined->toExpression->state, transition->toExpression->state) ){
+            if ( isDeterministic )
                 logError(_logger,"%s it is not deterministic due to the following transitions:",AUTOMATA_NOT_CREATED);
-                logError(_logger,"\t|%s|-%s->|%s|", fromState->symbol.value, symbol->value, toState->symbol.value);
-                logError(_logger,"\t|%s|-%s->|%s|", transition->fromExpression->state->symbol.value, transition->symbolExpression->symbol->value, transition->toExpression->state->symbol.value);
-                return _invalidComputation();
-            }
-            otherNode = otherNode->next;
+            isDeterministic = false;
+            logError(_logger,"\t|%s|-%s->|%s|", defined->fromExpression->state->symbol.value, defined->symbolExpression->symbol->value, defined->toExpression->state->symbol.value);
+            logError(_logger,"\t|%s|-%s->|%s|", transition->fromExpression->state->symbol.value, transition->symbolExpression->symbol->value, transition->toExpression->state->symbol.value);
         }
         currentNode = currentNode->next; 
     }
-
+    if ( !isDeterministic ){
+        destroyTransitionFunctionIndex(index);
+        return _invalidComputation();
+    }
+    _keepTransitionFunction(index);
+    automata->transitionFunction = index;
     ComputationResult result = { .succeed = true };
     return result;
 }
 
+/* Guarda los estados y simbolos en arreglos, para no recorrer las listas en la generacion */
+static void _indexAutomata(StateSet * states, SymbolSet * alphabet, Automata * automata) {
+    automata->stateCount = 0;
+    for (StateNode * node = states->first; node != NULL; node = node->next)
+        automata->stateCount++;
+    automata->stateArray = allocateFromArena(_arena, (automata->stateCount == 0 ? 1 : automata->stateCount) * sizeof(State *));
+    unsigned int k = 0;
+    for (StateNode * node = states->first; node != NULL; node = node->next)
+        automata->stateArray[k++] = node->state;
+
+    automata->symbolCount = 0;
+    for (SymbolNode * node = alphabet->first; node != NULL; node = node->next)
+        automata->symbolCount++;
+    automata->symbolArray = allocateFromArena(_arena, (automata->symbolCount == 0 ? 1 : automata->symbolCount) * sizeof(Symbol *));
+    k = 0;
+    for (SymbolNode * node = alphabet->first; node != NULL; node = node->next)
+        automata->symbolArray[k++] = node->symbol;
+}
+
+static void _keepTransitionFunction(TransitionFunctionIndex * index) {
+    lockMutex(&_transitionFunctionsMutex);
+    if ( _transitionFunctionCount == _transitionFunctionCapacity ){
+        _transitionFunctionCapacity = _transitionFunctionCapacity == 0? 8 : 2 * _transitionFunctionCapacity;
+        _transitionFunctions = realloc(_transitionFunctions, _transitionFunctionCapacity * sizeof(TransitionFunctionIndex *));
+    }
+    _transitionFunctions[_transitionFunctionCount++] = index;
+    unlockMutex(&_transitionFunctionsMutex);
+}
+
 static ComputationResult _containsLambda(const SymbolSet * alphabet, AutomataType type)  {
     logInformation(_logger, "looking for lambda..");
-    Symbol * lambda = calloc(1,sizeof(Symbol));
-    lambda->value = LAMBDA_STRING; 
     ComputationResult result = {
-        .succeed = !containsSymbol(alphabet->first,lambda)
+        .succeed = !containsSymbol(alphabet->first,internSymbol(LAMBDA_STRING))
     };
-    free(lambda);
     
     if ( result.succeed )
         return result;
@@ -328,26 +486,128 @@ static ComputationResult _checkTransitionStatesAndSymbols(TransitionSet * transi
     TransitionNode * currentTransNode = transitions->first;
     Transition * transition;
     ComputationResult result ={ .succeed=false };
+    // pertenencia en O(1) sobre los ids internados, sin importar si el estado es final / initial:
+    // el estado marca (id << 2) y el simbolo (id << 2) | 1
+    Bitset * marks = _marks();
+    for (StateNode * node = states->first; node != NULL; node = node->next)
+        setBit(marks, node->state->symbol.id << 2);
+    for (SymbolNode * node = alphabet->first; node != NULL; node = node->next)
+        setBit(marks, (node->symbol->id << 2) | 1);
             
     while (currentTransNode != NULL) {
         transition = currentTransNode->transition;
     
-        if ( !containsState(states->first,transition->fromExpression->state ) || !containsState(states->first,transition->toExpression->state ) ) {
+        if ( !testBit(marks, transition->fromExpression->state->symbol.id << 2) || !testBit(marks, transition->toExpression->state->symbol.id << 2) ) {
             logError(_logger,"%s its transitions use states that don't belong to the automata", AUTOMATA_NOT_CREATED);
-            return result;
+            goto done;
         }
-        if ( !containsSymbol(alphabet->first,transition->symbolExpression->symbol ) ) {
+        if ( !testBit(marks, (transition->symbolExpression->symbol->id << 2) | 1) ) {
             logError(_logger,"%s its transitions use symbol %s that doesn't belong to the automata", AUTOMATA_NOT_CREATED, transition->symbolExpression->symbol->value);
-            return result;
+            goto done;
         }
 
         currentTransNode = currentTransNode->next;
     }
     result.succeed = true;
+done:
+    for (StateNode * node = states->first; node != NULL; node = node->next)
+        clearBit(marks, node->state->symbol.id << 2);
+    for (SymbolNode * node = alphabet->first; node != NULL; node = node->next)
+        clearBit(marks, (node->symbol->id << 2) | 1);
+    return result;
+}
+
+static boolean _isOperation(ExpressionType type) {
+    return type == UNION_EXPRESSION || type == INTERSECTION_EXPRESSION || type == DIFFERENCE_EXPRESSION;
+}
+
+/*
+ * Las operaciones que se repiten (en la misma o en otra definicion) se computan
+ * una sola vez: se devuelve una vista compartida del set cacheado, que quien la
+ * recibe copia antes de modificar. Los errores no se cachean.
+ * La clave no incluye isSingleElement: solo se cachean operaciones, que siempre
+ * dan un set. Si se cacheara algo que puede dar un elemento suelto, un hit
+ * devolveria un set donde se espera un elemento (lo chequea el assert).
+ */
+ComputationResult computeTransitionExpression(TransitionExpression * expression, boolean isSingleElement) {
+    char * key = _isOperation(expression->type) ? transitionExpressionKey(expression) : NULL;
+    if ( key == NULL )
+        return _computeTransitionExpression(expression, isSingleElement);
+    TransitionSet * cached = findCachedExpression(key);
+    if ( cached == NULL ){
+        ComputationResult result = _computeTransitionExpression(expression, isSingleElement);
+        if ( !result.succeed ){
+            free(key);
+            return result;
+        }
+        assert(!result.isSingleElement);
+        cached = result.transitionSet;
+        cacheExpression(key, cached);
+    }
+    else
+        free(key);
+    TransitionSet * set = allocateFromArena(_arena, sizeof(TransitionSet));
+    shareTransitionSet(set, cached);
+    ComputationResult result = {
+        .succeed = true,
+        .transitionSet = set
+    };
+    return result;
+}
+
+ComputationResult computeStateExpression(StateExpression * expression, boolean isSingleElement) {
+    char * key = _isOperation(expression->type) ? stateExpressionKey(expression) : NULL;
+    if ( key == NULL )
+        return _computeStateExpression(expression, isSingleElement);
+    StateSet * cached = findCachedExpression(key);
+    if ( cached == NULL ){
+        ComputationResult result = _computeStateExpression(expression, isSingleElement);
+        if ( !result.succeed ){
+            free(key);
+            return result;
+        }
+        assert(!result.isSingleElement);
+        cached = result.stateSet;
+        cacheExpression(key, cached);
+    }
+    else
+        free(key);
+    StateSet * set = allocateFromArena(_arena, sizeof(StateSet));
+    shareStateSet(set, cached);
+    ComputationResult result = {
+        .succeed = true,
+        .stateSet = set
+    };
     return result;
 }
 
-ComputationResult computeTransitionExpression(TransitionExpression * expression, boolean isSingleElement ){
+ComputationResult computeSymbolExpression(SymbolExpression * expression, boolean isSingleElement) {
+    char * key = _isOperation(expression->type) ? symbolExpressionKey(expression) : NULL;
+    if ( key == NULL )
+        return _computeSymbolExpression(expression, isSingleElement);
+    SymbolSet * cached = findCachedExpression(key);
+    if ( cached == NULL ){
+        ComputationResult result = _computeSymbolExpression(expression, isSingleElement);
+        if ( !result.succeed ){
+            free(key);
+            return result;
+        }
+        assert(!result.isSingleElement);
+        cached = result.symbolSet;
+        cacheExpression(key, cached);
+    }
+    else
+        free(key);
+    SymbolSet * set = allocateFromArena(_arena, sizeof(SymbolSet));
+    shareSymbolSet(set, cached);
+    ComputationResult result = {
+        .succeed = true,
+        .symbolSet = set
+    };
+    return result;
+}
+
+static ComputationResult _computeTransitionExpression(TransitionExpression * expression, boolean isSingleElement ){
     ComputationResult result;
     switch ( expression->type) {
         case UNION_EXPRESSION:
@@ -378,7 +638,7 @@ ComputationResult computeTransitionExpression(TransitionExpression * expression,
     }
 }
 
-ComputationResult computeStateExpression(StateExpression * expression,  boolean isSingleElement) {
+static ComputationResult _computeStateExpression(StateExpression * expression,  boolean isSingleElement) {
     switch ( expression->type) {
         case UNION_EXPRESSION:
                     return _stateUnion(expression->leftExpression, expression->rightExpression);
@@ -401,7 +661,7 @@ ComputationResult computeStateExpression(StateExpression * expression,  boolean
 }
 
 
-ComputationResult computeSymbolExpression(SymbolExpression * expression, boolean isSingleElement) {
+static ComputationResult _computeSymbolExpression(SymbolExpression * expression, boolean isSingleElement) {
     switch ( expression->type) {
         case UNION_EXPRESSION:
                 return _symbolUnion(expression->leftExpression, expression->rightExpression);
@@ -468,18 +728,15 @@ ComputationResult computeTransitionSet(TransitionSet* set, boolean isDefinition)
             logError(_logger,"%s %s",set->identifier, CONST_NOT_DEFINED);
             return _invalidComputation();
         }
-        TransitionSet * resultSet;
         if ( set->isFromAutomata ) {
             Automata * automata = result.value.automata;
-            resultSet = cpyTransitionSet( automata->transitions->transitionSet);
+            shareTransitionSet(set, automata->transitions->transitionSet);
         } else     
-            resultSet = cpyTransitionSet( result.value.transitionSet);
-        set->first = resultSet->first;
-        set->tail = resultSet->tail; 
+            shareTransitionSet(set, result.value.transitionSet);
     }
     else {
         TransitionNode * currentNode = set->first;
-        TransitionNode * previousNode = set->first;
+        TransitionNode * previousNode = NULL;
         while (currentNode != NULL){
             if (currentNode->type == EXPRESSION){
                 ComputationResult result = computeTransitionExpression(currentNode->transitionExpression, true);
@@ -488,12 +745,23 @@ ComputationResult computeTransitionSet(TransitionSet* set, boolean isDefinition)
                         currentNode->transition = result.transition;
                         currentNode->type = ELEMENT;
                     }
+                    else if (result.transitionSet->first == NULL){
+                        // no genera transiciones: el nodo se saca del set
+                        if (previousNode == NULL)
+                            set->first = currentNode->next;
+                        else
+                            previousNode->next = currentNode->next;
+                        currentNode = currentNode->next;
+                        continue;
+                    }
                     else{
-                        TransitionNode * originalNext = currentNode->next;
-                        currentNode->transition = result.transitionSet->first->transition; 
-                        result.transitionSet->tail->next = originalNext;
-                        currentNode->next = result.transitionSet->first->next;
-                        currentNode = result.transitionSet->tail;
+                        ownTransitionSet(result.transitionSet, _arena);
+                        TransitionNode * firstNode = result.transitionSet->first;
+                        TransitionNode * tailNode = result.transitionSet->tail;
+                        tailNode->next = currentNode->next;
+                        *currentNode = *firstNode;      // el primer nodo puede ser un producto
+                        if (firstNode != tailNode)
+                            currentNode = tailNode;
                     }
                 }
                 else{
@@ -508,7 +776,8 @@ ComputationResult computeTransitionSet(TransitionSet* set, boolean isDefinition)
         set->tail = previousNode; 
     }
     logInformation(_logger, "Transition set created");
-    deleteRepetitionsFromTransitionSet(set);
+    if ( !set->isShared )       // un snapshot de la tabla ya no tiene repetidos
+        deleteRepetitionsFromTransitionSet(set);
     logInformation(_logger, "Deleted repetitions from transition set");
     
     result.transitionSet = set;
@@ -520,6 +789,7 @@ ComputationResult computeTransitionSet(TransitionSet* set, boolean isDefinition)
 /* Elimina los estados que no son del tipo indicado en type */
 static void _filterStates( StateSet * set, StateType type){
     logInformation(_logger, "Filtering...");
+    ownStateSet(set, _arena);
     StateNode * currentNode = set->first;
     State * currentState;
     StateNode * resultTail = NULL;
@@ -562,31 +832,23 @@ ComputationResult computeStateSet(StateSet* set, boolean isDefinition) {
             logError(_logger,"%s %s",set->identifier, CONST_NOT_DEFINED);
             return _invalidComputation();
         }
-        StateSet * resultSet;
         if (set->isFromAutomata) {
             Automata * automata = result.value.automata; 
             switch(set->stateType){
                 case FINAL: 
-                    resultSet = cpyStateSet(automata->finals->stateSet); break;
+                    shareStateSet(set, automata->finals->stateSet); break;
                 case INITIAL: 
-                    StateNode * node = calloc(1,sizeof(StateNode));
-                    node->state = calloc(1,sizeof(State));
-                    node->state->symbol = automata->initials->state->symbol;
-                    node->state->isFinal = automata->initials->state->isFinal;
-                    node->state->isInitial = automata->initials->state->isInitial;
-                    resultSet = calloc(1,sizeof(StateSet));
+                    StateNode * node = allocateFromArena(_arena, sizeof(StateNode));
+                    node->state = automata->initials->state;
                     node->type = ELEMENT;
-                    resultSet->first = node;
-                    resultSet->tail = node; 
-                    
+                    set->first = node;
+                    set->tail = node; 
                     break;
                 default: 
-                    resultSet = cpyStateSet( automata->states->stateSet); break;            
+                    shareStateSet(set, automata->states->stateSet); break;            
             }
         } else 
-            resultSet = cpyStateSet( result.value.stateSet);
-        set->first = resultSet->first; 
-        set->tail = resultSet->tail;
+            shareStateSet(set, result.value.stateSet);
     }
     if ( (set->stateType != MIXED && !set->isFromAutomata) || set->stateType==REGULAR ) {
             _filterStates(set, set->stateType);
@@ -604,11 +866,14 @@ ComputationResult computeStateSet(StateSet* set, boolean isDefinition) {
                     }
                     else{
                         if (result.stateSet->first != NULL){
+                            ownStateSet(result.stateSet, _arena);
                             StateNode * originalNext = currentNode->next;
                             currentNode->state = result.stateSet->first->state; 
+                            currentNode->type = ELEMENT;
                             result.stateSet->tail->next = originalNext;
                             currentNode->next = result.stateSet->first->next;
-                            currentNode = result.stateSet->tail;
+                            if (result.stateSet->first != result.stateSet->tail)
+                                currentNode = result.stateSet->tail;
                         }
                     }
                 }else{
@@ -621,7 +886,8 @@ ComputationResult computeStateSet(StateSet* set, boolean isDefinition) {
         }
         set->tail = previousNode;
     }
-    deleteRepetitionsFromStateSet(set);
+    if ( !set->isShared )
+        deleteRepetitionsFromStateSet(set);
     logDebugging(_logger,"Deleted repetitions from state set");
     result.stateSet = set;
     return result;
@@ -640,14 +906,11 @@ ComputationResult computeSymbolSet(SymbolSet* set, boolean isDefinition) {
             logError(_logger,"%s %s",set->identifier, CONST_NOT_DEFINED);
             return _invalidComputation();
         }
-        SymbolSet * resultSet;
         if ( set->isFromAutomata ) {
             Automata * automata =result.value.automata;
-            resultSet = cpySymbolSet( automata->alphabet->symbolSet);
+            shareSymbolSet(set, automata->alphabet->symbolSet);
         } else     
-            resultSet = cpySymbolSet( result.value.symbolSet);
-        set->first = resultSet->first;
-        set->tail = resultSet->tail; 
+            shareSymbolSet(set, result.value.symbolSet);
     } else {
         SymbolNode * currentNode = set->first;
         SymbolNode * previousNode = set->first;
@@ -662,11 +925,14 @@ ComputationResult computeSymbolSet(SymbolSet* set, boolean isDefinition) {
                     }
                     else{
                         if (result.symbolSet->first != NULL){
+                            ownSymbolSet(result.symbolSet, _arena);
                             SymbolNode * originalNext = currentNode->next;
                             currentNode->symbol = result.symbolSet->first->symbol; 
+                            currentNode->type = ELEMENT;
                             result.symbolSet->tail->next = originalNext;
                             currentNode->next = result.symbolSet->first->next;
-                            currentNode = result.symbolSet->tail;
+                            if (result.symbolSet->first != result.symbolSet->tail)
+                                currentNode = result.symbolSet->tail;
                         }
                     }
                 }
@@ -679,7 +945,8 @@ ComputationResult computeSymbolSet(SymbolSet* set, boolean isDefinition) {
         }
         set->tail = previousNode;
     }
-    deleteRepetitionsFromSymbolSet(set);
+    if ( !set->isShared )
+        deleteRepetitionsFromSymbolSet(set);
     result.symbolSet = set;
     return result;
 }
@@ -688,95 +955,50 @@ ComputationResult computeTransition(Transition* transition, boolean isSingleElem
     ComputationResult computationResult = {
 		.succeed = false
 	};
-    logInformation(_logger, "--------Computing transition object------");
+    logDebugging(_logger, "--------Computing transition object------");
     StateExpression * stateExpression = transition->fromExpression;
     ComputationResult result1 = computeStateExpression(stateExpression, false);
     if (!result1.succeed){
         return computationResult;
     }
-    logInformation(_logger, "From state set for transition created");
+    logDebugging(_logger, "From state set for transition created");
     
     SymbolExpression * symbolExpression = transition->symbolExpression;
     ComputationResult result2 = computeSymbolExpression(symbolExpression, false);
     if (!result2.succeed){
         return computationResult;
     }
-    logInformation(_logger, "elements consumed created for transition created");
+    logDebugging(_logger, "elements consumed created for transition created");
 
     stateExpression = transition->toExpression;
     ComputationResult result3 = computeStateExpression(stateExpression,false);
     if (!result3.succeed){
         return computationResult;
     }
-    logInformation(_logger, "To state set for transition created");
+    logDebugging(_logger, "To state set for transition created");
     
 
-    boolean isSimpleTransition = result1.stateSet->first == result1.stateSet->tail && result2.symbolSet->first == result2.symbolSet->tail && result3.stateSet->first == result3.stateSet->tail;
-    if ( isSingleElement && isSimpleTransition){
-        logInformation(_logger, "Simple transition detected ready to be returned");
+    boolean isEmptyTransition = result1.stateSet->first == NULL || result2.symbolSet->first == NULL || result3.stateSet->first == NULL;
+    boolean isSimpleTransition = !isEmptyTransition && result1.stateSet->first == result1.stateSet->tail && result2.symbolSet->first == result2.symbolSet->tail && result3.stateSet->first == result3.stateSet->tail;
+    if ( isSimpleTransition ){
+        logDebugging(_logger, "Simple transition detected ready to be returned");
         transition->fromExpression->state = result1.stateSet->first->state;
         transition->symbolExpression->symbol = result2.symbolSet->first->symbol;
         transition->toExpression->state = result3.stateSet->first->state;
-        computationResult.transition = transition;
-        computationResult.isSingleElement = true;
+        if ( isSingleElement ){
+            computationResult.transition = transition;
+            computationResult.isSingleElement = true;
+        } else 
+            computationResult.transitionSet = _singletonTransitionSet(transition, ELEMENT);
+    } else if ( isEmptyTransition ){
+        computationResult.transitionSet = allocateFromArena(_arena, sizeof(TransitionSet));
     } else {
+        // el producto from x simbolo x to queda simbolico hasta que alguien itere sus transiciones
         transition->fromExpression->stateSet = result1.stateSet;
         transition->symbolExpression->symbolSet = result2.symbolSet;
         transition->toExpression->stateSet = result3.stateSet;
-
-        TransitionSet * set = malloc(sizeof(TransitionSet));        
-
-        StateNode * pivotFromNode = transition->fromExpression->stateSet->first;
-        SymbolNode * pivotSymbolNode = transition->symbolExpression->symbolSet->first;
-        StateNode * pivotToNode = transition->toExpression->stateSet->first;
-
-        TransitionNode * firstNode = calloc(1, sizeof(TransitionNode));
-        set->first = firstNode;
-
-        while(pivotFromNode != NULL){
-            while(pivotSymbolNode != NULL){
-                while(pivotToNode != NULL){
-                    Transition * newTransition = malloc(sizeof(Transition));
-                    StateExpression * newFromExpression = calloc(1, sizeof(StateExpression));
-                    SymbolExpression * newSymbolExpression = calloc(1, sizeof(SymbolExpression));
-                    StateExpression* newToExpression = calloc(1, sizeof(StateExpression));
-
-                    newFromExpression->state = pivotFromNode->state;
-                    newTransition->fromExpression = newFromExpression;
-
-                    newSymbolExpression->symbol = pivotSymbolNode->symbol;
-                    newTransition->symbolExpression = newSymbolExpression;
-
-                    newToExpression->state = pivotToNode->state;
-                    newTransition->toExpression = newToExpression;
-
-                    if (firstNode->transition != NULL){
-                        TransitionNode * newNode = malloc(sizeof(TransitionNode));
-                        newNode->transition = newTransition;
-                        newNode->type = ELEMENT;
-                        if (set->tail != NULL){
-                            set->tail->next = newNode;
-                        }
-                        set->tail = newNode;
-                    }else{
-                        firstNode->transition = newTransition;
-                        firstNode->type = ELEMENT;
-                        set->tail = firstNode;
-                    }
-                    logInformation(_logger, "Transition added: %s -%s-> %s", newTransition->fromExpression->state->symbol.value, newTransition->symbolExpression->symbol->value, newTransition->toExpression->state->symbol.value);
-                    pivotToNode = pivotToNode->next;
-                }
-                logInformation(_logger, "All to states were used");
-                pivotSymbolNode = pivotSymbolNode->next;
-                pivotToNode = transition->toExpression->stateSet->first;
-            }
-            logInformation(_logger, "All symbols were consumed");
-            pivotFromNode = pivotFromNode->next;
-            pivotSymbolNode = transition->symbolExpression->symbolSet->first;
-        }
-        computationResult.transitionSet = set;
-        computationResult.isSingleElement = set->first == set->tail;
-        logInformation(_logger, "All from states were used, preparing to return set");
+        computationResult.transitionSet = _singletonTransitionSet(transition, PRODUCT);
+        logDebugging(_logger, "Product transition ready to be returned");
     }
     computationResult.succeed = true;
     return computationResult;
@@ -792,8 +1014,8 @@ ComputationResult computeSymbol(Symbol* symbol, boolean isSingleElement) {
         computationResult.symbol = symbol;
         computationResult.isSingleElement = true;
     } else {
-        SymbolSet * set = malloc(sizeof(SymbolSet));
-        SymbolNode * node = calloc(1,sizeof(SymbolNode));
+        SymbolSet * set = allocateFromArena(_arena, sizeof(SymbolSet));
+        SymbolNode * node = allocateFromArena(_arena, sizeof(SymbolNode));
         node->symbol = symbol;
         node->type = ELEMENT;
         set->first = node;  
@@ -814,8 +1036,8 @@ ComputationResult computeState(State* state, boolean isSingleElement ) {
         computationResult.state = state;
         computationResult.isSingleElement = true;
     } else {
-        StateSet * set = malloc(sizeof(StateSet));
-        StateNode * node = calloc(1,sizeof(StateNode));
+        StateSet * set = allocateFromArena(_arena, sizeof(StateSet));
+        StateNode * node = allocateFromArena(_arena, sizeof(StateNode));
         node->state = state;
         node->type = ELEMENT;
         set->first = node;
@@ -833,12 +1055,15 @@ ComputationResult computeState(State* state, boolean isSingleElement ) {
 
 /*----------------------------- UNION -----------------------------------------------*/
 static ComputationResult _transitionUnion(TransitionExpression * leftExp, TransitionExpression * rightExp){
+    countStatistic(UNION_OPERATIONS, 1);
     ComputationResult left = computeTransitionExpression(leftExp, false);
     ComputationResult right = computeTransitionExpression(rightExp, false);
     if (left.succeed && right.succeed){
-        TransitionSet * result = calloc(1, sizeof(TransitionSet));
+        TransitionSet * result = allocateFromArena(_arena, sizeof(TransitionSet));
         TransitionSet * leftSet = left.transitionSet;
         TransitionSet * rightSet = right.transitionSet;
+        ownTransitionSet(leftSet, _arena);
+        ownTransitionSet(rightSet, _arena);
         if (leftSet->first != NULL){
             result->first = leftSet->first;
             leftSet->tail->next = rightSet->first; 
@@ -863,6 +1088,7 @@ static ComputationResult _transitionUnion(TransitionExpression * leftExp, Transi
 }
 
 static ComputationResult _stateUnion(StateExpression * leftExp, StateExpression * rightExp){
+    countStatistic(UNION_OPERATIONS, 1);
     ComputationResult left = computeStateExpression(leftExp, false);
     ComputationResult right = computeStateExpression(rightExp, false);
     if (left.succeed && right.succeed){
@@ -872,7 +1098,13 @@ static ComputationResult _stateUnion(StateExpression * leftExp, StateExpression
 }
 
 static ComputationResult _stateSetUnion(StateSet * leftSet, StateSet * rightSet){
-    StateSet * result = calloc(1, sizeof(StateSet));
+    StateSet * result = allocateFromArena(_arena, sizeof(StateSet));
+    ownStateSet(leftSet, _arena);
+    ownStateSet(rightSet, _arena);
+    // _keepMarkedStates apaga todas las marcas, porque recorre los dos operandos
+    Bitset * marks = _marks();
+    _markStates(leftSet, marks);
+    _markStates(rightSet, marks);
     if (leftSet->first != NULL){
         result->first = leftSet->first;
         leftSet->tail->next = rightSet->first; 
@@ -886,7 +1118,7 @@ static ComputationResult _stateSetUnion(StateSet * leftSet, StateSet * rightSet)
     }    
 
     if (result->first != NULL){
-        deleteRepetitionsFromStateSet(result);
+        _keepMarkedStates(result, marks);
     }
 
     ComputationResult ret = {
@@ -897,6 +1129,7 @@ static ComputationResult _stateSetUnion(StateSet * leftSet, StateSet * rightSet)
 }
 
 static ComputationResult _symbolUnion(SymbolExpression * leftExp, SymbolExpression * rightExp){
+    countStatistic(UNION_OPERATIONS, 1);
     ComputationResult left = computeSymbolExpression(leftExp, false);
     ComputationResult right = computeSymbolExpression(rightExp, false);
     if (left.succeed && right.succeed){
@@ -906,7 +1139,13 @@ static ComputationResult _symbolUnion(SymbolExpression * leftExp, SymbolExpressi
 }
 
 static ComputationResult _symbolSetUnion(SymbolSet * leftSet, SymbolSet * rightSet){
-    SymbolSet * result = calloc(1, sizeof(SymbolSet));
+    SymbolSet * result = allocateFromArena(_arena, sizeof(SymbolSet));
+    ownSymbolSet(leftSet, _arena);
+    ownSymbolSet(rightSet, _arena);
+    // _keepMarkedSymbols apaga todas las marcas, porque recorre los dos operandos
+    Bitset * marks = _marks();
+    _markSymbols(leftSet, marks);
+    _markSymbols(rightSet, marks);
     if (leftSet->first != NULL){
         result->first = leftSet->first;
         leftSet->tail->next = rightSet->first; 
@@ -920,7 +1159,7 @@ static ComputationResult _symbolSetUnion(SymbolSet * leftSet, SymbolSet * rightS
     }
 
     if (result->first != NULL){
-        deleteRepetitionsFromSymbolSet(result);
+        _keepMarkedSymbols(result, marks);
     }
     ComputationResult ret = {
         .succeed = true,
@@ -931,10 +1170,11 @@ static ComputationResult _symbolSetUnion(SymbolSet * leftSet, SymbolSet * rightS
 
 /*------------------------------ INTERSECTION -------------------------------------*/
 static ComputationResult _transitionIntersection(TransitionExpression * leftExp, TransitionExpression * rightExp){
+    countStatistic(INTERSECTION_OPERATIONS, 1);
     ComputationResult left = computeTransitionExpression(leftExp, false);
     ComputationResult right = computeTransitionExpression(rightExp, false);
     if (left.succeed && right.succeed){
-        TransitionSet * result = calloc(1, sizeof(TransitionSet));
+        TransitionSet * result = allocateFromArena(_arena, sizeof(TransitionSet));
         _transitionIntersectionResolution(left.transitionSet, right.transitionSet, result);
         ComputationResult computationResult = {
             .succeed = true,
@@ -946,45 +1186,27 @@ static ComputationResult _transitionIntersection(TransitionExpression * leftExp,
 }
 
 static void _transitionIntersectionResolution(TransitionSet * leftSet, TransitionSet * rightSet, TransitionSet * result){
-    TransitionNode * leftCurrentNode = leftSet->first;
-    TransitionNode * rightCurrentNode = rightSet->first;
-    TransitionNode * resultCurrentNode = NULL; 
     result->first = NULL;
-    int found = 0;
-    if (leftSet->tail == NULL || rightSet->tail == NULL){
+    if (leftSet->first == NULL || rightSet->first == NULL){
         return;
     }
-    while (leftCurrentNode != NULL && !found){
-        //dejo un nodo para comparar contra todos los nodos del otro set
-        while (rightCurrentNode != NULL && !found){
-            if (transitionEquals(leftCurrentNode->transition, rightCurrentNode->transition)){
-                found = 1;
-                resultCurrentNode = calloc(1, sizeof(TransitionNode));
-                resultCurrentNode->transition= leftCurrentNode->transition;
-                if (result->tail == NULL){
-                    result->first = resultCurrentNode;
-                }
-                if (result->tail != NULL){
-                    result->tail->next = resultCurrentNode;
-                }
-                result->tail = resultCurrentNode;
-                break;
-            }
-            rightCurrentNode = rightCurrentNode->next;
-        }
-        leftCurrentNode = leftCurrentNode->next;
-        rightCurrentNode = rightSet->first;
-        found = 0;
-    }    
-    freeTransitionSet(leftSet);
-    freeTransitionSet(rightSet);
+    if (_isSingleProduct(leftSet) && _isSingleProduct(rightSet)){
+        _productIntersection(leftSet->first->transition, rightSet->first->transition, result);
+        return;
+    }
+    _expandTransitionSet(leftSet);
+    _expandTransitionSet(rightSet);
+    TransitionIndex * rightIndex = _transitionIndex(rightSet);
+    _appendIndexedTransitions(leftSet, rightIndex, true, result);
+    destroyTransitionIndex(rightIndex);
 }
 
 static ComputationResult _stateIntersection(StateExpression * leftExp, StateExpression * rightExp){
+    countStatistic(INTERSECTION_OPERATIONS, 1);
     ComputationResult left = computeStateExpression(leftExp, false);
     ComputationResult right = computeStateExpression(rightExp, false);
     if (left.succeed && right.succeed){
-        StateSet * result = calloc(1, sizeof(StateSet));
+        StateSet * result = allocateFromArena(_arena, sizeof(StateSet));
         _stateIntersectionResolution(left.stateSet, right.stateSet, result);
         ComputationResult computationResult = {
             .succeed = true,
@@ -996,45 +1218,23 @@ static ComputationResult _stateIntersection(StateExpression * leftExp, StateExpr
 }
 
 static void _stateIntersectionResolution(StateSet * leftSet, StateSet * rightSet, StateSet * result){
-    StateNode * leftCurrentNode = leftSet->first;
-    StateNode * rightCurrentNode = rightSet->first;
-    StateNode * resultCurrentNode = NULL;
     result->first = NULL;
-    int found = 0;
-    if (leftSet->tail == NULL || rightSet->tail == NULL){
+    if (leftSet->first == NULL || rightSet->first == NULL){
         return;
     }
-    while (leftCurrentNode != NULL && !found){
-        //dejo un nodo para comparar contra todos los nodos del otro set
-        while (rightCurrentNode != NULL && !found){
-            if (stateEquals(leftCurrentNode->state, rightCurrentNode->state)){
-                found = 1;
-                resultCurrentNode = calloc(1, sizeof(StateNode));
-                resultCurrentNode->state = leftCurrentNode->state;
-                if (result->tail == NULL){
-                    result->first = resultCurrentNode;
-                }
-                if (result->tail != NULL){
-                    result->tail->next = resultCurrentNode;
-                }
-                result->tail = resultCurrentNode;
-                break;
-            }
-            rightCurrentNode = rightCurrentNode->next;
-        }
-        leftCurrentNode = leftCurrentNode->next;
-        rightCurrentNode = rightSet->first;
-        found = 0;
-    }        
-    freeStateSet(leftSet);
-    freeStateSet(rightSet);
+    Bitset * marks = _marks();
+    _markStates(rightSet, marks);
+    _appendMarkedStates(leftSet, marks, result);
+    // quedan encendidos los que solo estan a derecha
+    _clearStates(rightSet, marks);
 }
 
 static ComputationResult _symbolIntersection(SymbolExpression * leftExp, SymbolExpression * rightExp){
+    countStatistic(INTERSECTION_OPERATIONS, 1);
     ComputationResult left = computeSymbolExpression(leftExp, false);
     ComputationResult right = computeSymbolExpression(rightExp, false);
     if (left.succeed && right.succeed){
-        SymbolSet * result = calloc(1, sizeof(SymbolSet));
+        SymbolSet * result = allocateFromArena(_arena, sizeof(SymbolSet));
         _symbolIntersectionResolution(left.symbolSet, right.symbolSet, result);
         ComputationResult computationResult = {
             .succeed = true,
@@ -1046,46 +1246,24 @@ static ComputationResult _symbolIntersection(SymbolExpression * leftExp, SymbolE
 }
 
 static void _symbolIntersectionResolution(SymbolSet * leftSet, SymbolSet * rightSet, SymbolSet * result){
-    SymbolNode * leftCurrentNode = leftSet->first;
-    SymbolNode * rightCurrentNode = rightSet->first;
-    SymbolNode * resultCurrentNode = NULL; 
     result->first = NULL;
-    int found = 0;
-    if (leftSet->tail == NULL || rightSet->tail == NULL){
+    if (leftSet->first == NULL || rightSet->first == NULL){
         return;
     }
-    while (leftCurrentNode != NULL && !found){
-        //dejo un nodo para comparar contra todos los nodos del otro set
-        while (rightCurrentNode != NULL && !found){
-            if (symbolEquals(leftCurrentNode->symbol, rightCurrentNode->symbol)){
-                found = 1;
-                resultCurrentNode = calloc(1, sizeof(SymbolNode));
-                resultCurrentNode->symbol= leftCurrentNode->symbol;
-                if (result->tail == NULL){
-                    result->first = resultCurrentNode;
-                }
-                if (result->tail != NULL){
-                    result->tail->next = resultCurrentNode;
-                }
-                result->tail = resultCurrentNode;
-                break;
-            }
-            rightCurrentNode = rightCurrentNode->next;
-        }
-        leftCurrentNode = leftCurrentNode->next;
-        rightCurrentNode = rightSet->first;
-        found = 0;
-    }    
-    freeSymbolSet(leftSet);
-    freeSymbolSet(rightSet);
+    Bitset * marks = _marks();
+    _markSymbols(rightSet, marks);
+    _appendMarkedSymbols(leftSet, marks, result);
+    // quedan encendidos los que solo estan a derecha
+    _clearSymbols(rightSet, marks);
 }
 
 /*-------------------------------------- DIFFERENCE -----------------------------*/
 static ComputationResult _transitionDifference(TransitionExpression * leftExp, TransitionExpression * rightExp){
+    countStatistic(DIFFERENCE_OPERATIONS, 1);
     ComputationResult left = computeTransitionExpression(leftExp, false);
     ComputationResult right = computeTransitionExpression(rightExp, false);
     if (left.succeed && right.succeed){
-        TransitionSet * result = calloc(1, sizeof(TransitionSet));
+        TransitionSet * result = allocateFromArena(_arena, sizeof(TransitionSet));
         _transitionDifferenceResolution(left.transitionSet, right.transitionSet, result);
         ComputationResult computationResult = {
             .succeed = true,
@@ -1097,52 +1275,23 @@ static ComputationResult _transitionDifference(TransitionExpression * leftExp, T
 }
 
 static void _transitionDifferenceResolution(TransitionSet * leftSet, TransitionSet * rightSet, TransitionSet * result){
-    TransitionNode * leftCurrentNode = leftSet->first;
-    TransitionNode * rightCurrentNode = rightSet->first;
-    TransitionNode * resultCurrentNode = NULL; 
-    result->first = NULL;      
-    int found = 0;
-    if (leftSet->tail == NULL){
-        return;
-    }
-    if (rightSet->tail == NULL){
-        result = leftSet;
+    result->first = NULL;
+    if (leftSet->first == NULL){
         return;
     }
-    while (leftCurrentNode != NULL && !found){
-        //dejo un nodo para comparar contra todos los nodos del otro set
-        while (rightCurrentNode != NULL && !found){
-            if (transitionEquals(leftCurrentNode->transition, rightCurrentNode->transition)){
-                found = 1;
-                break;
-            }
-            rightCurrentNode = rightCurrentNode->next;
-        }
-        if (!found){
-            resultCurrentNode = calloc(1, sizeof(TransitionNode));
-            resultCurrentNode->transition= leftCurrentNode->transition;
-            if (result->tail == NULL){
-                result->first = resultCurrentNode;
-            }
-            if (result->tail != NULL){
-                result->tail->next = resultCurrentNode;
-            }
-            result->tail = resultCurrentNode;
-        }
-        leftCurrentNode = leftCurrentNode->next;
-        rightCurrentNode = rightSet->first;
-        found = 0;
-    }
-
-    freeTransitionSet(leftSet);
-    freeTransitionSet(rightSet);
+    _expandTransitionSet(leftSet);
+    _expandTransitionSet(rightSet);
+    TransitionIndex * rightIndex = _transitionIndex(rightSet);
+    _appendIndexedTransitions(leftSet, rightIndex, false, result);
+    destroyTransitionIndex(rightIndex);
 }
 
 static ComputationResult _stateDifference(StateExpression * leftExp, StateExpression * rightExp){
+    countStatistic(DIFFERENCE_OPERATIONS, 1);
     ComputationResult left = computeStateExpression(leftExp, false);
     ComputationResult right = computeStateExpression(rightExp, false);
     if (left.succeed && right.succeed){
-        StateSet * result = calloc(1, sizeof(StateSet));
+        StateSet * result = allocateFromArena(_arena, sizeof(StateSet));
         _stateDifferenceResolution(left.stateSet, right.stateSet, result);
         ComputationResult computationResult = {
             .succeed = true,
@@ -1154,52 +1303,22 @@ static ComputationResult _stateDifference(StateExpression * leftExp, StateExpres
 }
 
 static void _stateDifferenceResolution(StateSet * leftSet, StateSet * rightSet, StateSet * result){
-    StateNode * leftCurrentNode = leftSet->first;
-    StateNode * rightCurrentNode = rightSet->first;
-    StateNode * resultCurrentNode = NULL; 
-    result->first = resultCurrentNode;
-    int found = 0;
-    if (leftSet->first== NULL){
-        return;
-    }
-    if (rightSet->first== NULL){
-        result = leftSet;
+    result->first = NULL;
+    if (leftSet->first == NULL){
         return;
     }
-    while (leftCurrentNode != NULL && !found){
-        //dejo un nodo para comparar contra todos los nodos del otro set
-        while (rightCurrentNode != NULL && !found){
-            if (stateEquals(leftCurrentNode->state, rightCurrentNode->state)){
-                found = 1;
-                break;
-            }
-            rightCurrentNode = rightCurrentNode->next;
-        }
-        if (!found){
-            resultCurrentNode = calloc(1, sizeof(StateNode));
-            resultCurrentNode->state = leftCurrentNode->state;
-            if (result->tail == NULL){
-                result->first = resultCurrentNode;
-            }
-            if (result->tail != NULL){
-                result->tail->next = resultCurrentNode;
-            }
-            result->tail = resultCurrentNode;
-        }
-        leftCurrentNode = leftCurrentNode->next;
-        rightCurrentNode = rightSet->first;
-        found = 0;
-    }
-    //free the nodes from left and right sets
-    freeStateSet(leftSet);
-    freeStateSet(rightSet);
+    Bitset * marks = _marks();
+    _markStates(leftSet, marks);
+    _clearStates(rightSet, marks);
+    _appendMarkedStates(leftSet, marks, result);
 }
 
 static ComputationResult _symbolDifference(SymbolExpression * leftExp, SymbolExpression * rightExp){
+    countStatistic(DIFFERENCE_OPERATIONS, 1);
     ComputationResult left = computeSymbolExpression(leftExp, false);
     ComputationResult right = computeSymbolExpression(rightExp, false);
     if (left.succeed && right.succeed){
-        SymbolSet * result = calloc(1, sizeof(SymbolSet));
+        SymbolSet * result = allocateFromArena(_arena, sizeof(SymbolSet));
         _symbolDifferenceResolution(left.symbolSet, right.symbolSet, result);
         ComputationResult computationResult = {
             .succeed = true,
@@ -1211,111 +1330,352 @@ static ComputationResult _symbolDifference(SymbolExpression * leftExp, SymbolExp
 }
 
 static void _symbolDifferenceResolution(SymbolSet * leftSet, SymbolSet * rightSet, SymbolSet * result){
-    SymbolNode * leftCurrentNode = leftSet->first;
-    SymbolNode * rightCurrentNode = rightSet->first;
-    SymbolNode * resultCurrentNode = NULL; 
     result->first = NULL;
-    int found = 0;
-    if (leftSet->tail == NULL){
-        return;
-    }
-    if (rightSet->tail == NULL){
-        result = leftSet;
+    if (leftSet->first == NULL){
         return;
     }
-    while (leftCurrentNode != NULL && !found){
-        //dejo un nodo para comparar contra todos los nodos del otro set
-        while (rightCurrentNode != NULL && !found){
-            if (symbolEquals(leftCurrentNode->symbol, rightCurrentNode->symbol)){
-                found = 1;
-                break;
-            }
-            rightCurrentNode = rightCurrentNode->next;
-        }
-        if (!found){
-            resultCurrentNode = calloc(1, sizeof(SymbolNode));
-            resultCurrentNode->symbol= leftCurrentNode->symbol;
-            if (result->tail == NULL){
-                result->first = resultCurrentNode;
-            }
-            if (result->tail != NULL){
-                result->tail->next = resultCurrentNode;
-            }
-            result->tail = resultCurrentNode;
-        }
-        leftCurrentNode = leftCurrentNode->next;
-        rightCurrentNode = rightSet->first;
-        found = 0;
-    }
-    freeSymbolSet(leftSet);
-    freeSymbolSet(rightSet);
+    Bitset * marks = _marks();
+    _markSymbols(leftSet, marks);
+    _clearSymbols(rightSet, marks);
+    _appendMarkedSymbols(leftSet, marks, result);
 }
 
 /*---------------------------------------------- DELETE REPETITIONS FROM SET -----------------------------------------*/
+// una sola pasada: el indice de hash recuerda lo que ya se vio, se conserva la primera aparicion
+// los productos se deduplican recien cuando se expanden
 static void deleteRepetitionsFromTransitionSet(TransitionSet * set){
+    TransitionIndex * index = createTransitionIndex();
     TransitionNode * current = set->first;
     TransitionNode * next;
-    TransitionNode * lastSeen;
+    TransitionNode * lastSeen = NULL;
 
     while (current != NULL){
         next = current->next;
-        lastSeen = current;
-        while(next != NULL){
-            if (transitionEquals(current->transition, next->transition)){
-                lastSeen->next = next->next;
-                free(next);
-                next = lastSeen->next;
-            } else {
-                lastSeen = next;
-                next = next->next;
-            }
+        if (current->type == PRODUCT || addTransition(index, current->transition)){
+            lastSeen = current;
+        } else {
+            lastSeen->next = next;
         }
-        current = current->next;
+        current = next;
     }
+    set->tail = lastSeen;
+    destroyTransitionIndex(index);
 }
 
 static void deleteRepetitionsFromStateSet(StateSet * set){
+    StateIndex * index = createStateIndex();
     StateNode * current = set->first;
     StateNode * next;
-    StateNode * lastSeen;
+    StateNode * lastSeen = NULL;
 
     while (current != NULL){
         next = current->next;
-        lastSeen = current;
-        while(next != NULL){
-            if (stateEquals(current->state, next->state)){
-                lastSeen->next = next->next;
-                free(next);
-                next = lastSeen->next;
-            } else {
-                lastSeen = next;
-                next = next->next;
-            }
+        if (addState(index, current->state)){
+            lastSeen = current;
+        } else {
+            lastSeen->next = next;
         }
-        current = current->next;
+        current = next;
     }
+    set->tail = lastSeen;
+    destroyStateIndex(index);
 }
 
 static void deleteRepetitionsFromSymbolSet(SymbolSet * set){
+    SymbolIndex * index = createSymbolIndex();
     SymbolNode * current = set->first;
     SymbolNode * next;
-    SymbolNode * lastSeen;
+    SymbolNode * lastSeen = NULL;
 
     while (current != NULL){
         next = current->next;
-        lastSeen = current;
-        while(next != NULL){
-            if (symbolEquals(current->symbol, next->symbol)){
-                lastSeen->next = next->next;
-                free(next);
-                next = lastSeen->next;
-            } else {
-                lastSeen = next;
-                next = next->next;
+        if (addSymbol(index, current->symbol)){
+            lastSeen = current;
+        } else {
+            lastSeen->next = next;
+        }
+        current = next;
+    }
+    set->tail = lastSeen;
+    destroySymbolIndex(index);
+}
+
+/*---------------------------------------------- TRANSITION INDEX -----------------------------------------*/
+static TransitionIndex * _transitionIndex(TransitionSet * set){
+    TransitionIndex * index = createTransitionIndex();
+    TransitionNode * current = set->first;
+    while (current != NULL){
+        addTransition(index, current->transition);
+        current = current->next;
+    }
+    return index;
+}
+
+/* Agrega a result, en el orden de set, las transiciones que estan (o no, segun contained) en el indice */
+static void _appendIndexedTransitions(TransitionSet * set, TransitionIndex * index, boolean contained, TransitionSet * result){
+    TransitionNode * current = set->first;
+    TransitionNode * resultCurrentNode;
+    while (current != NULL){
+        if (indexContainsTransition(index, current->transition) == contained){
+            resultCurrentNode = allocateFromArena(_arena, sizeof(TransitionNode));
+            resultCurrentNode->transition = current->transition;
+            resultCurrentNode->type = ELEMENT;
+            if (result->tail == NULL)
+                result->first = resultCurrentNode;
+            else
+                result->tail->next = resultCurrentNode;
+            result->tail = resultCurrentNode;
+        }
+        current = current->next;
+    }
+}
+
+/*---------------------------------------------- TRANSITION PRODUCTS -----------------------------------------*/
+static TransitionSet * _singletonTransitionSet(Transition * transition, NodeType type){
+    TransitionSet * set = allocateFromArena(_arena, sizeof(TransitionSet));
+    TransitionNode * node = allocateFromArena(_arena, sizeof(TransitionNode));
+    node->transition = transition;
+    node->type = type;
+    set->first = node;
+    set->tail = node;
+    return set;
+}
+
+static boolean _isSingleProduct(TransitionSet * set){
+    return set->first == set->tail && set->first->type == PRODUCT;
+}
+
+/* (F x S x T) n (F' x S' x T') = (F n F') x (S n S') x (T n T'), en el mismo orden que expandir y filtrar */
+static void _productIntersection(Transition * leftProduct, Transition * rightProduct, TransitionSet * result){
+    StateSet * fromSet = allocateFromArena(_arena, sizeof(StateSet));
+    SymbolSet * symbolSet = allocateFromArena(_arena, sizeof(SymbolSet));
+    StateSet * toSet = allocateFromArena(_arena, sizeof(StateSet));
+    _stateIntersectionResolution(leftProduct->fromExpression->stateSet, rightProduct->fromExpression->stateSet, fromSet);
+    _symbolIntersectionResolution(leftProduct->symbolExpression->symbolSet, rightProduct->symbolExpression->symbolSet, symbolSet);
+    _stateIntersectionResolution(leftProduct->toExpression->stateSet, rightProduct->toExpression->stateSet, toSet);
+    if (fromSet->first == NULL || symbolSet->first == NULL || toSet->first == NULL){
+        return;
+    }
+    Transition * product = allocateFromArena(_arena, sizeof(Transition));
+    product->fromExpression = allocateFromArena(_arena, sizeof(StateExpression));
+    product->fromExpression->stateSet = fromSet;
+    product->fromExpression->type = SET_EXPRESSION;
+    product->symbolExpression = allocateFromArena(_arena, sizeof(SymbolExpression));
+    product->symbolExpression->symbolSet = symbolSet;
+    product->symbolExpression->type = SET_EXPRESSION;
+    product->toExpression = allocateFromArena(_arena, sizeof(StateExpression));
+    product->toExpression->stateSet = toSet;
+    product->toExpression->type = SET_EXPRESSION;
+    TransitionSet * productSet = _singletonTransitionSet(product, PRODUCT);
+    result->first = productSet->first;
+    result->tail = productSet->tail;
+}
+
+/* Materializa los productos del set en orden (from, simbolo, to), conservando la primera aparicion de cada transicion */
+static void _expandTransitionSet(TransitionSet * set){
+    TransitionNode * current = set->first;
+    while (current != NULL && current->type != PRODUCT){
+        current = current->next;
+    }
+    if (current == NULL){
+        return;
+    }
+    ownTransitionSet(set, _arena);
+    TransitionIndex * index = createTransitionIndex();
+    TransitionNode * next;
+    current = set->first;
+    set->first = NULL;
+    set->tail = NULL;
+    while (current != NULL){
+        next = current->next;
+        if (current->type == PRODUCT)
+            _appendProduct(current->transition, index, set);
+        else if (addTransition(index, current->transition))
+            _appendTransitionNode(set, current);
+        current = next;
+    }
+    destroyTransitionIndex(index);
+}
+
+static void _appendProduct(Transition * product, TransitionIndex * index, TransitionSet * result){
+    StateSet * fromSet = product->fromExpression->stateSet;
+    SymbolSet * symbolSet = product->symbolExpression->symbolSet;
+    StateSet * toSet = product->toExpression->stateSet;
+    unsigned int toCount = 0;
+    for (StateNode * toNode = toSet->first; toNode != NULL; toNode = toNode->next){
+        toCount++;
+    }
+    // una expresion por estado / simbolo, compartida por todas las transiciones que lo usan
+    StateExpression ** toExpressions = allocateFromArena(_arena, toCount * sizeof(StateExpression *));
+    for (StateNode * fromNode = fromSet->first; fromNode != NULL; fromNode = fromNode->next){
+        StateExpression * fromExpression = NULL;
+        for (SymbolNode * symbolNode = symbolSet->first; symbolNode != NULL; symbolNode = symbolNode->next){
+            SymbolExpression * symbolExpression = NULL;
+            unsigned int toPosition = 0;
+            for (StateNode * toNode = toSet->first; toNode != NULL; toNode = toNode->next, toPosition++){
+                TransitionKey key = {
+                    .from = stateKey(fromNode->state),
+                    .symbol = symbolNode->symbol->id,
+                    .to = stateKey(toNode->state)
+                };
+                if (!addTransitionKey(index, key))
+                    continue;
+                if (fromExpression == NULL){
+                    fromExpression = allocateFromArena(_arena, sizeof(StateExpression));
+                    fromExpression->state = fromNode->state;
+                    fromExpression->type = ELEMENT_EXPRESSION;
+                }
+                if (symbolExpression == NULL){
+                    symbolExpression = allocateFromArena(_arena, sizeof(SymbolExpression));
+                    symbolExpression->symbol = symbolNode->symbol;
+                    symbolExpression->type = ELEMENT_EXPRESSION;
+                }
+                if (toExpressions[toPosition] == NULL){
+                    toExpressions[toPosition] = allocateFromArena(_arena, sizeof(StateExpression));
+                    toExpressions[toPosition]->state = toNode->state;
+                    toExpressions[toPosition]->type = ELEMENT_EXPRESSION;
+                }
+                Transition * transition = allocateFromArena(_arena, sizeof(Transition));
+                transition->fromExpression = fromExpression;
+                transition->symbolExpression = symbolExpression;
+                transition->toExpression = toExpressions[toPosition];
+                TransitionNode * node = allocateFromArena(_arena, sizeof(TransitionNode));
+                node->transition = transition;
+                node->type = ELEMENT;
+                _appendTransitionNode(result, node);
             }
         }
+    }
+}
+
+static void _appendTransitionNode(TransitionSet * set, TransitionNode * node){
+    node->next = NULL;
+    if (set->tail == NULL)
+        set->first = node;
+    else
+        set->tail->next = node;
+    set->tail = node;
+}
+
+/*---------------------------------------------- BITSETS -----------------------------------------*/
+static void _destroyMarks(void * marks){
+    destroyBitset(marks);
+}
+
+// el universo de claves crece con el pool, pero el bitset se reserva una vez por hilo
+static Bitset * _marks(void){
+    Bitset * marks = getThreadValue(&_marksKey);
+    const unsigned int size = symbolPoolSize() << 2;
+    if (marks == NULL){
+        marks = createBitset(size);
+        setThreadValue(&_marksKey, marks);
+    }
+    else {
+        growBitset(marks, size);
+    }
+    return marks;
+}
+
+static void _markStates(StateSet * set, Bitset * marks){
+    for (StateNode * current = set->first; current != NULL; current = current->next)
+        setBit(marks, stateKey(current->state));
+}
+
+static void _clearStates(StateSet * set, Bitset * marks){
+    for (StateNode * current = set->first; current != NULL; current = current->next)
+        clearBit(marks, stateKey(current->state));
+}
+
+static void _markSymbols(SymbolSet * set, Bitset * marks){
+    for (SymbolNode * current = set->first; current != NULL; current = current->next)
+        setBit(marks, current->symbol->id);
+}
+
+static void _clearSymbols(SymbolSet * set, Bitset * marks){
+    for (SymbolNode * current = set->first; current != NULL; current = current->next)
+        clearBit(marks, current->symbol->id);
+}
+
+/* Deja en el set solo la primera aparicion de cada elemento marcado */
+static void _keepMarkedStates(StateSet * set, Bitset * marks){
+    StateNode * current = set->first;
+    StateNode * next;
+    StateNode * lastSeen = NULL;
+    while (current != NULL){
+        next = current->next;
+        if (testAndClearBit(marks, stateKey(current->state))){
+            if (lastSeen == NULL)
+                set->first = current;
+            else
+                lastSeen->next = current;
+            lastSeen = current;
+        }
+        current = next;
+    }
+    if (lastSeen == NULL)
+        set->first = NULL;
+    else
+        lastSeen->next = NULL;
+    set->tail = lastSeen;
+}
+
+static void _keepMarkedSymbols(SymbolSet * set, Bitset * marks){
+    SymbolNode * current = set->first;
+    SymbolNode * next;
+    SymbolNode * lastSeen = NULL;
+    while (current != NULL){
+        next = current->next;
+        if (testAndClearBit(marks, current->symbol->id)){
+            if (lastSeen == NULL)
+                set->first = current;
+            else
+                lastSeen->next = current;
+            lastSeen = current;
+        }
+        current = next;
+    }
+    if (lastSeen == NULL)
+        set->first = NULL;
+    else
+        lastSeen->next = NULL;
+    set->tail = lastSeen;
+}
+
+/* Agrega a result, en el orden de set, los elementos marcados */
+static void _appendMarkedStates(StateSet * set, Bitset * marks, StateSet * result){
+    StateNode * current = set->first;
+    StateNode * resultCurrentNode;
+    while (current != NULL){
+        if (testAndClearBit(marks, stateKey(current->state))){
+            resultCurrentNode = allocateFromArena(_arena, sizeof(StateNode));
+            resultCurrentNode->state = current->state;
+            resultCurrentNode->type = ELEMENT;
+            if (result->tail == NULL)
+                result->first = resultCurrentNode;
+            else
+                result->tail->next = resultCurrentNode;
+            result->tail = resultCurrentNode;
+        }
         current = current->next;
-    } 
+    }
+}
+
+static void _appendMarkedSymbols(SymbolSet * set, Bitset * marks, SymbolSet * result){
+    SymbolNode * current = set->first;
+    SymbolNode * resultCurrentNode;
+    while (current != NULL){
+        if (testAndClearBit(marks, current->symbol->id)){
+            resultCurrentNode = allocateFromArena(_arena, sizeof(SymbolNode));
+            resultCurrentNode->symbol = current->symbol;
+            resultCurrentNode->type = ELEMENT;
+            if (result->tail == NULL)
+                result->first = resultCurrentNode;
+            else
+                result->tail->next = resultCurrentNode;
+            result->tail = resultCurrentNode;
+        }
+        current = current->next;
+    }
 }
 
 /*--------------------------------------------- INVALID OPERATORS -----------------------------------------*/
@@ -7,11 +7,17 @@
  * domain-specific models or DTOs (Data Transfer Objects).
  */
 #include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Arena.h"
 #include "../../shared/Logger.h"
 #include "../../shared/Type.h"
+#include <assert.h>
 #include <limits.h>
 
 #include "utils.h"
+#include "Bitset.h"
+#include "DefinitionScheduler.h"
+#include "ExpressionCache.h"
+#include "SetIndex.h"
 #include "Table.h"
 
 
@@ -42,7 +48,15 @@ typedef struct {
     DefinitionType type;
 } ComputationResult;
 
-ComputationResult computeDefinitionSet(DefinitionSet * definitionSet);
+/** Every allocation of the computation lives in the arena of the compilation. */
+ComputationResult computeDefinitionSet(DefinitionSet * definitionSet, Arena * arena);
+/**
+ * Computes the definitions of the program: in the specified amount of
+ * threads (see "scheduleDefinitions"), or in order with "computeDefinitionSet"
+ * if there is only one. With "ELIMINATE_DEAD_DEFINITIONS", only the
+ * definitions that the automata need are computed (see "liveDefinitionSet").
+ */
+ComputationResult computeDefinitions(DefinitionSet * definitionSet, Arena * arena, const unsigned int threads);
 ComputationResult computeDefinition(Definition * definition);
 ComputationResult computeAutomata(Automata * automata);
 ComputationResult computeTransitionExpression(TransitionExpression * expression, boolean isSingleElement );
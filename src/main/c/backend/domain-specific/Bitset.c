@@ -0,0 +1,49 @@
+#include "Bitset.h"
+
+static unsigned int _wordCount(unsigned int size) {
+    const unsigned int wordCount = (size + 63) / 64;
+    return wordCount == 0 ? 1 : wordCount;
+}
+
+Bitset * createBitset(unsigned int size) {
+    Bitset * bitset = calloc(1, sizeof(Bitset));
+    bitset->wordCount = _wordCount(size);
+    bitset->words = calloc(bitset->wordCount, sizeof(uint64_t));
+    return bitset;
+}
+
+void growBitset(Bitset * bitset, unsigned int size) {
+    const unsigned int wordCount = _wordCount(size);
+    if (wordCount <= bitset->wordCount) {
+        return;
+    }
+    bitset->words = realloc(bitset->words, wordCount * sizeof(uint64_t));
+    memset(bitset->words + bitset->wordCount, 0, (wordCount - bitset->wordCount) * sizeof(uint64_t));
+    bitset->wordCount = wordCount;
+}
+
+void destroyBitset(Bitset * bitset) {
+    if (bitset != NULL) {
+        free(bitset->words);
+        free(bitset);
+    }
+}
+
+void setBit(Bitset * bitset, unsigned int bit) {
+    bitset->words[bit >> 6] |= (uint64_t) 1 << (bit & 63);
+}
+
+void clearBit(Bitset * bitset, unsigned int bit) {
+    bitset->words[bit >> 6] &= ~((uint64_t) 1 << (bit & 63));
+}
+
+boolean testBit(const Bitset * bitset, unsigned int bit) {
+    return (bitset->words[bit >> 6] >> (bit & 63)) & 1;
+}
+
+boolean testAndClearBit(Bitset * bitset, unsigned int bit) {
+    uint64_t mask = (uint64_t) 1 << (bit & 63);
+    boolean wasSet = (bitset->words[bit >> 6] & mask) != 0;
+    bitset->words[bit >> 6] &= ~mask;
+    return wasSet;
+}
@@ -0,0 +1,30 @@
+#ifndef BITSET_HEADER
+#define BITSET_HEADER
+
+#include "../../shared/Type.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A word-packed set over a dense universe of ids [0, size). The set algebra
+ * marks the ids of one operand and tests the other element by element, so it
+ * costs the size of the operands instead of the size of the universe.
+ */
+typedef struct {
+    uint64_t * words;
+    unsigned int wordCount;
+} Bitset;
+
+Bitset * createBitset(unsigned int size);
+void destroyBitset(Bitset * bitset);
+/** Makes room for ids in [0, size), keeping the bits already set. */
+void growBitset(Bitset * bitset, unsigned int size);
+
+void setBit(Bitset * bitset, unsigned int bit);
+void clearBit(Bitset * bitset, unsigned int bit);
+boolean testBit(const Bitset * bitset, unsigned int bit);
+/** @return true si el bit estaba encendido (y lo apaga) */
+boolean testAndClearBit(Bitset * bitset, unsigned int bit);
+
+#endif
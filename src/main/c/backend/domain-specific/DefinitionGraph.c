@@ -0,0 +1,235 @@
+#include "DefinitionGraph.h"
+#include "khash.h"
+
+/* MODULE INTERNAL STATE */
+
+KHASH_MAP_INIT_STR(definitionByName, unsigned int)
+
+/**
+ * The state of the walk that marks the live definitions.
+ */
+typedef struct {
+    khash_t(definitionByName) * positions;
+    boolean * live;
+    unsigned int * pending;
+    unsigned int pendingCount;
+} LivenessWalk;
+
+typedef struct {
+    ReferenceVisitor visitor;
+    void * context;
+} ReferenceWalk;
+
+static Logger * _logger = NULL;
+
+void initializeDefinitionGraphModule() {
+    _logger = createLogger("DefinitionGraph");
+}
+
+void shutdownDefinitionGraphModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+/* PRIVATE FUNCTIONS */
+
+static void _referencesInStateExpression(ReferenceWalk * walk, StateExpression * expression);
+static void _referencesInStateSet(ReferenceWalk * walk, StateSet * set, boolean isDefinition);
+static void _referencesInSymbolExpression(ReferenceWalk * walk, SymbolExpression * expression);
+static void _referencesInSymbolSet(ReferenceWalk * walk, SymbolSet * set, boolean isDefinition);
+static void _referencesInTransitionExpression(ReferenceWalk * walk, TransitionExpression * expression);
+static void _referencesInTransitionSet(ReferenceWalk * walk, TransitionSet * set, boolean isDefinition);
+static void _markLive(const char * identifier, void * context);
+
+static void _referencesInStateExpression(ReferenceWalk * walk, StateExpression * expression) {
+    switch (expression->type) {
+        case UNION_EXPRESSION:
+        case INTERSECTION_EXPRESSION:
+        case DIFFERENCE_EXPRESSION:
+            _referencesInStateExpression(walk, expression->leftExpression);
+            _referencesInStateExpression(walk, expression->rightExpression);
+            break;
+        case SET_EXPRESSION:
+            _referencesInStateSet(walk, expression->stateSet, false);
+            break;
+        default:
+            break;
+    }
+}
+
+// el set de una definicion lleva el identificador que define, no uno que referencia
+static void _referencesInStateSet(ReferenceWalk * walk, StateSet * set, boolean isDefinition) {
+    if (set->identifier != NULL && !isDefinition) {
+        walk->visitor(set->identifier, walk->context);
+    }
+    for (StateNode * node = set->first; node != NULL; node = node->next) {
+        if (node->type == EXPRESSION)
+            _referencesInStateExpression(walk, node->stateExpression);
+    }
+}
+
+static void _referencesInSymbolExpression(ReferenceWalk * walk, SymbolExpression * expression) {
+    switch (expression->type) {
+        case UNION_EXPRESSION:
+        case INTERSECTION_EXPRESSION:
+        case DIFFERENCE_EXPRESSION:
+            _referencesInSymbolExpression(walk, expression->leftExpression);
+            _referencesInSymbolExpression(walk, expression->rightExpression);
+            break;
+        case SET_EXPRESSION:
+            _referencesInSymbolSet(walk, expression->symbolSet, false);
+            break;
+        default:
+            break;
+    }
+}
+
+static void _referencesInSymbolSet(ReferenceWalk * walk, SymbolSet * set, boolean isDefinition) {
+    if (set->identifier != NULL && !isDefinition) {
+        walk->visitor(set->identifier, walk->context);
+    }
+    for (SymbolNode * node = set->first; node != NULL; node = node->next) {
+        if (node->type == EXPRESSION)
+            _referencesInSymbolExpression(walk, node->symbolExpression);
+    }
+}
+
+static void _referencesInTransitionExpression(ReferenceWalk * walk, TransitionExpression * expression) {
+    switch (expression->type) {
+        case UNION_EXPRESSION:
+        case INTERSECTION_EXPRESSION:
+        case DIFFERENCE_EXPRESSION:
+            _referencesInTransitionExpression(walk, expression->leftExpression);
+            _referencesInTransitionExpression(walk, expression->rightExpression);
+            break;
+        case SET_EXPRESSION:
+            _referencesInTransitionSet(walk, expression->transitionSet, false);
+            break;
+        case ELEMENT_EXPRESSION:
+            _referencesInStateExpression(walk, expression->transition->fromExpression);
+            _referencesInSymbolExpression(walk, expression->transition->symbolExpression);
+            _referencesInStateExpression(walk, expression->transition->toExpression);
+            break;
+    }
+}
+
+static void _referencesInTransitionSet(ReferenceWalk * walk, TransitionSet * set, boolean isDefinition) {
+    if (set->identifier != NULL && !isDefinition) {
+        walk->visitor(set->identifier, walk->context);
+    }
+    for (TransitionNode * node = set->first; node != NULL; node = node->next) {
+        if (node->type == EXPRESSION)
+            _referencesInTransitionExpression(walk, node->transitionExpression);
+    }
+}
+
+// una referencia a un identificador es una referencia a su (unica) definicion
+static void _markLive(const char * identifier, void * context) {
+    LivenessWalk * walk = context;
+    khiter_t k = kh_get(definitionByName, walk->positions, identifier);
+    if (k == kh_end(walk->positions)) {
+        return;
+    }
+    const unsigned int position = kh_value(walk->positions, k);
+    if (!walk->live[position]) {
+        walk->live[position] = true;
+        walk->pending[walk->pendingCount++] = position;
+    }
+}
+
+/* PUBLIC FUNCTIONS */
+
+char * definitionIdentifier(Definition * definition) {
+    switch (definition->type) {
+        case AUTOMATA_DEFINITION:
+            return definition->automata->identifier;
+        case TRANSITION_DEFINITION:
+            return definition->transitionSet->identifier;
+        case ALPHABET_DEFINITION:
+            return definition->symbolSet->identifier;
+        case STATE_DEFINITION:
+            return definition->stateSet->identifier;
+        default:
+            return "";
+    }
+}
+
+void visitDefinitionReferences(Definition * definition, ReferenceVisitor visitor, void * context) {
+    ReferenceWalk walk = {
+        .visitor = visitor,
+        .context = context
+    };
+    switch (definition->type) {
+        case AUTOMATA_DEFINITION:
+            _referencesInStateExpression(&walk, definition->automata->states);
+            _referencesInSymbolExpression(&walk, definition->automata->alphabet);
+            _referencesInTransitionExpression(&walk, definition->automata->transitions);
+            break;
+        case TRANSITION_DEFINITION:
+            _referencesInTransitionSet(&walk, definition->transitionSet, true);
+            break;
+        case ALPHABET_DEFINITION:
+            _referencesInSymbolSet(&walk, definition->symbolSet, true);
+            break;
+        case STATE_DEFINITION:
+            _referencesInStateSet(&walk, definition->stateSet, true);
+            break;
+    }
+}
+
+DefinitionSet * liveDefinitionSet(DefinitionSet * definitionSet, Arena * arena) {
+    unsigned int count = 0;
+    for (DefinitionNode * node = definitionSet->first; node != NULL; node = node->next) {
+        count++;
+    }
+    Definition ** definitions = malloc((count == 0 ? 1 : count) * sizeof(Definition *));
+    LivenessWalk walk = {
+        .positions = kh_init(definitionByName),
+        .live = calloc(count == 0 ? 1 : count, sizeof(boolean)),
+        .pending = malloc((count == 0 ? 1 : count) * sizeof(unsigned int)),
+        .pendingCount = 0
+    };
+    DefinitionSet * liveSet = NULL;
+    unsigned int position = 0;
+    for (DefinitionNode * node = definitionSet->first; node != NULL; node = node->next, ++position) {
+        definitions[position] = node->definition;
+        int ret;
+        khiter_t k = kh_put(definitionByName, walk.positions, definitionIdentifier(node->definition), &ret);
+        if (ret <= 0) {
+            logError(_logger, "There cannot be 2 definitions with the same name: %s", definitionIdentifier(node->definition));
+            goto release;
+        }
+        kh_value(walk.positions, k) = position;
+        if (node->definition->type == AUTOMATA_DEFINITION) {
+            walk.live[position] = true;
+            walk.pending[walk.pendingCount++] = position;
+        }
+    }
+    // cada definicion viva marca las que referencia, hasta que no quedan pendientes
+    while (0 < walk.pendingCount) {
+        visitDefinitionReferences(definitions[walk.pending[--walk.pendingCount]], _markLive, &walk);
+    }
+    liveSet = allocateFromArena(arena, sizeof(DefinitionSet));
+    unsigned int liveCount = 0;
+    for (position = 0; position < count; ++position) {
+        if (!walk.live[position]) {
+            continue;
+        }
+        DefinitionNode * liveNode = allocateFromArena(arena, sizeof(DefinitionNode));
+        liveNode->definition = definitions[position];
+        if (liveSet->first == NULL)
+            liveSet->first = liveNode;
+        else
+            liveSet->tail->next = liveNode;
+        liveSet->tail = liveNode;
+        liveCount++;
+    }
+    logDebugging(_logger, "%u of %u definitions are needed by the automata.", liveCount, count);
+release:
+    kh_destroy(definitionByName, walk.positions);
+    free(walk.live);
+    free(walk.pending);
+    free(definitions);
+    return liveSet;
+}
@@ -0,0 +1,46 @@
+#ifndef DEFINITION_GRAPH_HEADER
+#define DEFINITION_GRAPH_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Arena.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include <stdlib.h>
+
+/**
+ * Receives every identifier that a definition references, with the context
+ * of the walk.
+ */
+typedef void (*ReferenceVisitor)(const char * identifier, void * context);
+
+/** Initialize module's internal state. */
+void initializeDefinitionGraphModule();
+
+/** Shutdown module's internal state. */
+void shutdownDefinitionGraphModule();
+
+/**
+ * The identifier that a definition introduces.
+ */
+char * definitionIdentifier(Definition * definition);
+
+/**
+ * Walks the (not computed yet) expressions of a definition, and visits every
+ * identifier they reference. An identifier referenced many times is visited
+ * many times.
+ */
+void visitDefinitionReferences(Definition * definition, ReferenceVisitor visitor, void * context);
+
+/**
+ * The definitions that the automata need: the automata themselves, and every
+ * definition they reference, directly or not. The result shares the
+ * definitions (but not the nodes) with the original set, in the same order.
+ * Since the unreferenced definitions are never computed, redefinitions are
+ * checked here, for every definition.
+ *
+ * @return el set de definiciones vivas, o NULL si hay un identificador
+ * definido dos veces
+ */
+DefinitionSet * liveDefinitionSet(DefinitionSet * definitionSet, Arena * arena);
+
+#endif
@@ -0,0 +1,311 @@
+#include "DefinitionScheduler.h"
+#include "khash.h"
+
+/* MODULE INTERNAL STATE */
+
+KHASH_MAP_INIT_STR(definitionPosition, unsigned int)
+
+/**
+ * A definition as a node of the dependency graph. Its dependents are a slice
+ * of the shared array of dependents (a compressed adjacency list).
+ */
+typedef struct {
+    Definition * definition;
+    unsigned int firstDependent;
+    unsigned int dependentCount;
+    atomic_uint pending;
+    atomic_bool blocked;
+} ScheduledDefinition;
+
+/**
+ * The definitions ready to run of a worker. The owner takes the newest ones
+ * (the dependents it just released), and the other workers steal the oldest.
+ * Every definition is pushed once, so the positions never wrap around.
+ */
+typedef struct {
+    unsigned int * positions;
+    unsigned int top;
+    unsigned int bottom;
+    Mutex mutex;
+} ReadyQueue;
+
+typedef struct {
+    ScheduledDefinition * definitions;
+    unsigned int count;
+    unsigned int * dependents;
+    ReadyQueue * queues;
+    unsigned int workers;
+    DefinitionTask task;
+    atomic_uint remaining;
+    atomic_uint firstFailure;
+} Scheduler;
+
+typedef struct {
+    Scheduler * scheduler;
+    unsigned int id;
+    Arena * arena;
+} Worker;
+
+/**
+ * The edges of the dependency graph, before they are compressed.
+ */
+typedef struct {
+    khash_t(definitionPosition) * positions;
+    unsigned int * from;
+    unsigned int * to;
+    unsigned int count;
+    unsigned int capacity;
+    unsigned int current;
+} GraphBuilder;
+
+static Logger * _logger = NULL;
+
+void initializeDefinitionSchedulerModule() {
+    _logger = createLogger("DefinitionScheduler");
+}
+
+void shutdownDefinitionSchedulerModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+/* PRIVATE FUNCTIONS */
+
+static void _addEdge(GraphBuilder * builder, const unsigned int from, const unsigned int to);
+static void _reference(const char * identifier, void * context);
+static void _push(ReadyQueue * queue, const unsigned int position);
+static boolean _pop(ReadyQueue * queue, unsigned int * position);
+static boolean _steal(Scheduler * scheduler, const unsigned int thief, unsigned int * position);
+static void _fail(Scheduler * scheduler, const unsigned int position);
+static void _run(Worker * worker, const unsigned int position);
+static void * _work(void * argument);
+
+static void _addEdge(GraphBuilder * builder, const unsigned int from, const unsigned int to) {
+    if (builder->count == builder->capacity) {
+        builder->capacity = builder->capacity == 0 ? 64 : 2 * builder->capacity;
+        builder->from = realloc(builder->from, builder->capacity * sizeof(unsigned int));
+        builder->to = realloc(builder->to, builder->capacity * sizeof(unsigned int));
+    }
+    builder->from[builder->count] = from;
+    builder->to[builder->count] = to;
+    builder->count++;
+}
+
+/**
+ * La definicion actual depende de la primera definicion del identificador si
+ * esta antes, y si esta despues tiene que esperar a que la actual termine (en
+ * una corrida secuencial el identificador todavia no existiria).
+ */
+static void _reference(const char * identifier, void * context) {
+    GraphBuilder * builder = context;
+    khiter_t k = kh_get(definitionPosition, builder->positions, identifier);
+    if (k == kh_end(builder->positions)) {
+        return;
+    }
+    const unsigned int position = kh_value(builder->positions, k);
+    if (position < builder->current) {
+        _addEdge(builder, position, builder->current);
+    }
+    else if (builder->current < position) {
+        _addEdge(builder, builder->current, position);
+    }
+}
+
+static void _push(ReadyQueue * queue, const unsigned int position) {
+    lockMutex(&queue->mutex);
+    queue->positions[queue->bottom++] = position;
+    unlockMutex(&queue->mutex);
+}
+
+static boolean _pop(ReadyQueue * queue, unsigned int * position) {
+    boolean found = false;
+    lockMutex(&queue->mutex);
+    if (queue->top < queue->bottom) {
+        *position = queue->positions[--queue->bottom];
+        found = true;
+    }
+    unlockMutex(&queue->mutex);
+    return found;
+}
+
+static boolean _steal(Scheduler * scheduler, const unsigned int thief, unsigned int * position) {
+    for (unsigned int k = 1; k < scheduler->workers; ++k) {
+        ReadyQueue * queue = &scheduler->queues[(thief + k) % scheduler->workers];
+        boolean found = false;
+        lockMutex(&queue->mutex);
+        if (queue->top < queue->bottom) {
+            *position = queue->positions[queue->top++];
+            found = true;
+        }
+        unlockMutex(&queue->mutex);
+        if (found) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// se queda con la menor posicion que falla, como en una corrida secuencial
+static void _fail(Scheduler * scheduler, const unsigned int position) {
+    unsigned int firstFailure = atomic_load(&scheduler->firstFailure);
+    while (position < firstFailure && !atomic_compare_exchange_weak(&scheduler->firstFailure, &firstFailure, position));
+}
+
+/**
+ * Runs a definition (unless a dependency failed, or an earlier definition
+ * already failed), and releases its dependents.
+ */
+static void _run(Worker * worker, const unsigned int position) {
+    Scheduler * scheduler = worker->scheduler;
+    ScheduledDefinition * scheduledDefinition = &scheduler->definitions[position];
+    boolean succeed = false;
+    if (!atomic_load(&scheduledDefinition->blocked) && position < atomic_load(&scheduler->firstFailure)) {
+        succeed = scheduler->task(scheduledDefinition->definition, worker->arena);
+        if (!succeed) {
+            _fail(scheduler, position);
+        }
+    }
+    for (unsigned int k = 0; k < scheduledDefinition->dependentCount; ++k) {
+        ScheduledDefinition * dependent = &scheduler->definitions[scheduler->dependents[scheduledDefinition->firstDependent + k]];
+        if (!succeed) {
+            atomic_store(&dependent->blocked, true);
+        }
+        if (atomic_fetch_sub(&dependent->pending, 1) == 1) {
+            _push(&scheduler->queues[worker->id], scheduler->dependents[scheduledDefinition->firstDependent + k]);
+        }
+    }
+    atomic_fetch_sub(&scheduler->remaining, 1);
+}
+
+static void * _work(void * argument) {
+    Worker * worker = argument;
+    Scheduler * scheduler = worker->scheduler;
+    unsigned int position;
+    const Timing start = startTiming();
+    while (0 < atomic_load(&scheduler->remaining)) {
+        if (_pop(&scheduler->queues[worker->id], &position) || _steal(scheduler, worker->id, &position)) {
+            _run(worker, position);
+        }
+        else {
+            yieldThread();
+        }
+    }
+    if (worker->id != 0) {
+        // el tiempo real ya lo mide el hilo principal, que tambien trabaja; falta el cpu de este hilo
+        Timing elapsed = elapsedTiming(start);
+        elapsed.wall = 0;
+        addPhaseTiming(COMPUTATION_PHASE, elapsed);
+        flushStatisticsCounters();
+    }
+    return NULL;
+}
+
+/* PUBLIC FUNCTIONS */
+
+int scheduleDefinitions(DefinitionSet * definitionSet, Arena * arena, const unsigned int threads, DefinitionTask task) {
+    Scheduler scheduler = {
+        .count = 0,
+        .task = task
+    };
+    for (DefinitionNode * node = definitionSet->first; node != NULL; node = node->next) {
+        scheduler.count++;
+    }
+    scheduler.definitions = calloc(scheduler.count, sizeof(ScheduledDefinition));
+
+    // las aristas: referencias y redefiniciones, desde la primera definicion de cada identificador
+    GraphBuilder builder = {
+        .positions = kh_init(definitionPosition),
+        .count = 0,
+        .capacity = 0
+    };
+    unsigned int position = 0;
+    for (DefinitionNode * node = definitionSet->first; node != NULL; node = node->next, ++position) {
+        scheduler.definitions[position].definition = node->definition;
+        int ret;
+        khiter_t k = kh_put(definitionPosition, builder.positions, definitionIdentifier(node->definition), &ret);
+        if (0 < ret) {
+            kh_value(builder.positions, k) = position;
+        }
+        else {
+            _addEdge(&builder, kh_value(builder.positions, k), position);
+        }
+    }
+    for (position = 0; position < scheduler.count; ++position) {
+        builder.current = position;
+        visitDefinitionReferences(scheduler.definitions[position].definition, _reference, &builder);
+    }
+    kh_destroy(definitionPosition, builder.positions);
+
+    // lista de adyacencia comprimida
+    scheduler.dependents = malloc((builder.count == 0 ? 1 : builder.count) * sizeof(unsigned int));
+    for (unsigned int k = 0; k < builder.count; ++k) {
+        scheduler.definitions[builder.from[k]].dependentCount++;
+        scheduler.definitions[builder.to[k]].pending++;
+    }
+    unsigned int offset = 0;
+    for (position = 0; position < scheduler.count; ++position) {
+        scheduler.definitions[position].firstDependent = offset;
+        offset += scheduler.definitions[position].dependentCount;
+        scheduler.definitions[position].dependentCount = 0;
+    }
+    for (unsigned int k = 0; k < builder.count; ++k) {
+        ScheduledDefinition * from = &scheduler.definitions[builder.from[k]];
+        scheduler.dependents[from->firstDependent + from->dependentCount++] = builder.to[k];
+    }
+    logDebugging(_logger, "Scheduling %u definitions with %u dependencies...", scheduler.count, builder.count);
+    free(builder.from);
+    free(builder.to);
+
+    scheduler.workers = threads < scheduler.count ? threads : scheduler.count;
+    if (scheduler.workers == 0) {
+        scheduler.workers = 1;
+    }
+    scheduler.queues = calloc(scheduler.workers, sizeof(ReadyQueue));
+    for (unsigned int k = 0; k < scheduler.workers; ++k) {
+        scheduler.queues[k].positions = malloc((scheduler.count == 0 ? 1 : scheduler.count) * sizeof(unsigned int));
+        initializeMutex(&scheduler.queues[k].mutex);
+    }
+    // al reves, para que cada worker empiece por las primeras definiciones
+    for (position = scheduler.count; 0 < position; --position) {
+        if (atomic_load(&scheduler.definitions[position - 1].pending) == 0) {
+            _push(&scheduler.queues[(position - 1) % scheduler.workers], position - 1);
+        }
+    }
+    atomic_init(&scheduler.remaining, scheduler.count);
+    atomic_init(&scheduler.firstFailure, scheduler.count);
+
+    Worker * workers = calloc(scheduler.workers, sizeof(Worker));
+    Thread * threadIds = calloc(scheduler.workers, sizeof(Thread));
+    unsigned int started = 1;
+    for (unsigned int k = 0; k < scheduler.workers; ++k) {
+        workers[k].scheduler = &scheduler;
+        workers[k].id = k;
+        workers[k].arena = k == 0 ? arena : createArena(ARENA_BLOCK_SIZE);
+    }
+    for (; started < scheduler.workers; ++started) {
+        if (!startThread(&threadIds[started], _work, &workers[started])) {
+            break;
+        }
+    }
+    // el hilo que llama tambien trabaja (y si no se pudo crear un hilo, roba su cola)
+    _work(&workers[0]);
+    for (unsigned int k = 1; k < started; ++k) {
+        joinThread(threadIds[k]);
+    }
+    for (unsigned int k = 1; k < scheduler.workers; ++k) {
+        mergeArena(arena, workers[k].arena);
+    }
+    const unsigned int firstFailure = atomic_load(&scheduler.firstFailure);
+
+    for (unsigned int k = 0; k < scheduler.workers; ++k) {
+        destroyMutex(&scheduler.queues[k].mutex);
+        free(scheduler.queues[k].positions);
+    }
+    free(threadIds);
+    free(workers);
+    free(scheduler.queues);
+    free(scheduler.dependents);
+    free(scheduler.definitions);
+    return firstFailure < scheduler.count ? (int) firstFailure : -1;
+}
@@ -0,0 +1,40 @@
+#ifndef DEFINITION_SCHEDULER_HEADER
+#define DEFINITION_SCHEDULER_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Arena.h"
+#include "../../shared/Concurrency.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Statistics.h"
+#include "../../shared/Type.h"
+#include <stdlib.h>
+
+#include "DefinitionGraph.h"
+
+/**
+ * Computes a definition with the specified arena (the one of the thread that
+ * runs it). Returns false if the definition fails.
+ */
+typedef boolean (*DefinitionTask)(Definition * definition, Arena * arena);
+
+/** Initialize module's internal state. */
+void initializeDefinitionSchedulerModule();
+
+/** Shutdown module's internal state. */
+void shutdownDefinitionSchedulerModule();
+
+/**
+ * Runs the task over every definition in a pool of threads. A definition runs
+ * after the earlier definitions of the identifiers it references (and of its
+ * own identifier, so redefinitions are detected), and before the later ones,
+ * so every definition sees the same table as in a sequential run. The
+ * definitions that depend on a failed one are skipped. Every thread other
+ * than the calling one allocates from its own arena, merged into the
+ * specified one at the end.
+ *
+ * @return la posicion (desde 0) de la primera definicion que falla, o -1 si
+ * todas tienen exito
+ */
+int scheduleDefinitions(DefinitionSet * definitionSet, Arena * arena, const unsigned int threads, DefinitionTask task);
+
+#endif
@@ -0,0 +1,220 @@
+#include "ExpressionCache.h"
+#include "khash.h"
+
+KHASH_MAP_INIT_STR(expressionCache, void *)
+
+/**
+ * A growing string, where the key of an expression is written. It becomes
+ * invalid if the expression has a part that can't be cached.
+ */
+typedef struct {
+    char * buffer;
+    size_t length;
+    size_t capacity;
+    boolean valid;
+} KeyBuilder;
+
+static khash_t(expressionCache) * _cache = NULL;
+
+// muchos lectores o un solo escritor, como la tabla
+static ReadWriteLock _lock = READ_WRITE_LOCK_INITIALIZER;
+
+void initializeExpressionCache(void){
+    _cache = kh_init(expressionCache);
+}
+
+void shutdownExpressionCache(void){
+    clearExpressionCache();
+    kh_destroy(expressionCache, _cache);
+    _cache = NULL;
+}
+
+/*----------------------------------------- PRIVATE FUNCTIONS ----------------------------------------------------*/
+static void _append(KeyBuilder * builder, const char * string);
+static void _appendOperator(KeyBuilder * builder, ExpressionType type);
+static void _appendReference(KeyBuilder * builder, const char * identifier, boolean isFromAutomata, StateType stateType);
+static void _stateKey(KeyBuilder * builder, const StateExpression * expression);
+static void _symbolKey(KeyBuilder * builder, const SymbolExpression * expression);
+static void _transitionKey(KeyBuilder * builder, const TransitionExpression * expression);
+static char * _buildKey(KeyBuilder * builder);
+
+static void _append(KeyBuilder * builder, const char * string){
+    const size_t length = strlen(string);
+    if ( builder->capacity <= builder->length + length ){
+        while ( builder->capacity <= builder->length + length )
+            builder->capacity = builder->capacity == 0 ? 64 : 2 * builder->capacity;
+        builder->buffer = realloc(builder->buffer, builder->capacity);
+    }
+    memcpy(builder->buffer + builder->length, string, length + 1);
+    builder->length += length;
+}
+
+static void _appendOperator(KeyBuilder * builder, ExpressionType type){
+    switch ( type ){
+        case UNION_EXPRESSION: _append(builder, "+"); break;
+        case INTERSECTION_EXPRESSION: _append(builder, "^"); break;
+        default: _append(builder, "-");
+    }
+}
+
+// los identificadores no pueden tener '#', '.' ni '/', asi que la clave no es ambigua
+static void _appendReference(KeyBuilder * builder, const char * identifier, boolean isFromAutomata, StateType stateType){
+    _append(builder, "#");
+    _append(builder, identifier);
+    if ( isFromAutomata )
+        _append(builder, ".a");
+    switch ( stateType ){
+        case FINAL: _append(builder, "/f"); break;
+        case INITIAL: _append(builder, "/i"); break;
+        case REGULAR: _append(builder, "/r"); break;
+        default: break;
+    }
+}
+
+static void _stateKey(KeyBuilder * builder, const StateExpression * expression){
+    switch ( expression->type ){
+        case UNION_EXPRESSION:
+        case INTERSECTION_EXPRESSION:
+        case DIFFERENCE_EXPRESSION:
+            _append(builder, "(");
+            _stateKey(builder, expression->leftExpression);
+            _appendOperator(builder, expression->type);
+            _stateKey(builder, expression->rightExpression);
+            _append(builder, ")");
+            break;
+        case SET_EXPRESSION:
+            // solo las referencias: los sets literales no se cachean
+            if ( expression->stateSet->identifier == NULL || expression->stateSet->first != NULL ){
+                builder->valid = false;
+                return;
+            }
+            _appendReference(builder, expression->stateSet->identifier, expression->stateSet->isFromAutomata, expression->stateSet->stateType);
+            break;
+        case ELEMENT_EXPRESSION:
+            _append(builder, "'");
+            _append(builder, expression->state->symbol.value);
+            if ( expression->state->isInitial )
+                _append(builder, ">");
+            if ( expression->state->isFinal )
+                _append(builder, "*");
+            break;
+        default:
+            builder->valid = false;
+    }
+}
+
+static void _symbolKey(KeyBuilder * builder, const SymbolExpression * expression){
+    switch ( expression->type ){
+        case UNION_EXPRESSION:
+        case INTERSECTION_EXPRESSION:
+        case DIFFERENCE_EXPRESSION:
+            _append(builder, "(");
+            _symbolKey(builder, expression->leftExpression);
+            _appendOperator(builder, expression->type);
+            _symbolKey(builder, expression->rightExpression);
+            _append(builder, ")");
+            break;
+        case SET_EXPRESSION:
+            if ( expression->symbolSet->identifier == NULL || expression->symbolSet->first != NULL ){
+                builder->valid = false;
+                return;
+            }
+            _appendReference(builder, expression->symbolSet->identifier, expression->symbolSet->isFromAutomata, MIXED);
+            break;
+        case ELEMENT_EXPRESSION:
+            _append(builder, "'");
+            _append(builder, expression->symbol->value);
+            break;
+        default:
+            builder->valid = false;
+    }
+}
+
+// las transiciones sueltas se computan sobre la misma expresion, asi que no se cachean
+static void _transitionKey(KeyBuilder * builder, const TransitionExpression * expression){
+    switch ( expression->type ){
+        case UNION_EXPRESSION:
+        case INTERSECTION_EXPRESSION:
+        case DIFFERENCE_EXPRESSION:
+            _append(builder, "(");
+            _transitionKey(builder, expression->leftExpression);
+            _appendOperator(builder, expression->type);
+            _transitionKey(builder, expression->rightExpression);
+            _append(builder, ")");
+            break;
+        case SET_EXPRESSION:
+            if ( expression->transitionSet->identifier == NULL || expression->transitionSet->first != NULL ){
+                builder->valid = false;
+                return;
+            }
+            _appendReference(builder, expression->transitionSet->identifier, expression->transitionSet->isFromAutomata, MIXED);
+            break;
+        default:
+            builder->valid = false;
+    }
+}
+
+static char * _buildKey(KeyBuilder * builder){
+    if ( !builder->valid ){
+        free(builder->buffer);
+        return NULL;
+    }
+    return builder->buffer;
+}
+
+/*----------------------------------------- KEYS ----------------------------------------------------*/
+char * stateExpressionKey(const StateExpression * expression){
+    KeyBuilder builder = { .valid = true };
+    _append(&builder, "Q");
+    _stateKey(&builder, expression);
+    return _buildKey(&builder);
+}
+
+char * symbolExpressionKey(const SymbolExpression * expression){
+    KeyBuilder builder = { .valid = true };
+    _append(&builder, "A");
+    _symbolKey(&builder, expression);
+    return _buildKey(&builder);
+}
+
+char * transitionExpressionKey(const TransitionExpression * expression){
+    KeyBuilder builder = { .valid = true };
+    _append(&builder, "T");
+    _transitionKey(&builder, expression);
+    return _buildKey(&builder);
+}
+
+/*----------------------------------------- CACHE ----------------------------------------------------*/
+void * findCachedExpression(const char * key){
+    void * set = NULL;
+    lockForReading(&_lock);
+    khiter_t k = kh_get(expressionCache, _cache, key);
+    if ( k != kh_end(_cache) )
+        set = kh_value(_cache, k);
+    unlockReadWriteLock(&_lock);
+    if ( set != NULL )
+        countStatistic(EXPRESSION_CACHE_HITS, 1);
+    return set;
+}
+
+void cacheExpression(char * key, void * set){
+    int ret;
+    lockForWriting(&_lock);
+    khiter_t k = kh_put(expressionCache, _cache, key, &ret);
+    if ( 0 < ret )
+        kh_value(_cache, k) = set;
+    unlockReadWriteLock(&_lock);
+    // otro hilo lo computo al mismo tiempo: se queda el primero
+    if ( ret <= 0 )
+        free(key);
+}
+
+void clearExpressionCache(void){
+    lockForWriting(&_lock);
+    for (khiter_t k = kh_begin(_cache); k != kh_end(_cache); ++k){
+        if ( kh_exist(_cache, k) )
+            free((char *) kh_key(_cache, k));
+    }
+    kh_clear(expressionCache, _cache);
+    unlockReadWriteLock(&_lock);
+}
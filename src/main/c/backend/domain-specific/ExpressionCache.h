@@ -0,0 +1,39 @@
+#ifndef EXPRESSION_CACHE_HEADER
+#define EXPRESSION_CACHE_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Concurrency.h"
+#include "../../shared/Statistics.h"
+#include "../../shared/Type.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A cache of the computed sets of the expressions, keyed by their structure
+ * (hash-consing), so an expression repeated across definitions is computed
+ * once. Only the expressions built from identifiers and single elements have
+ * a key: their value can't change during a compilation, because an
+ * identifier can't be redefined. The cached sets are snapshots: whoever
+ * receives one must share it (and copy it before modifying it), like the
+ * sets of the table.
+ */
+
+/* Las funciones de la cache se pueden llamar desde varios hilos a la vez */
+void initializeExpressionCache(void);
+void shutdownExpressionCache(void);
+
+/*----------------------------------------- KEYS ----------------------------------------------------*/
+/** @return la clave (en el heap) de la expresion, o NULL si no se puede cachear */
+char * stateExpressionKey(const StateExpression * expression);
+char * symbolExpressionKey(const SymbolExpression * expression);
+char * transitionExpressionKey(const TransitionExpression * expression);
+
+/*----------------------------------------- CACHE ----------------------------------------------------*/
+/** @return el set cacheado con la clave, o NULL */
+void * findCachedExpression(const char * key);
+/** La cache se queda con la clave (la libera si ya habia otro set con la misma) */
+void cacheExpression(char * key, void * set);
+/** Olvida todos los sets (que viven en la arena de la compilacion) */
+void clearExpressionCache(void);
+
+#endif
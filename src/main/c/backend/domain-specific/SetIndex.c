@@ -0,0 +1,164 @@
+#include "SetIndex.h"
+#include "khash.h"
+
+static inline khint_t _transitionKeyHash(TransitionKey key) {
+    khint64_t high = ((khint64_t) key.from << 32) | key.to;
+    return kh_int64_hash_func(high) ^ (key.symbol * 0x9E3779B1u);
+}
+
+static inline int _transitionKeyEquals(TransitionKey key1, TransitionKey key2) {
+    return key1.from == key2.from && key1.symbol == key2.symbol && key1.to == key2.to;
+}
+
+KHASH_SET_INIT_INT(stateIndex)
+KHASH_SET_INIT_INT(symbolIndex)
+KHASH_INIT(transitionIndex, TransitionKey, char, 0, _transitionKeyHash, _transitionKeyEquals)
+KHASH_MAP_INIT_INT64(transitionFunction, Transition *)
+
+struct StateIndex {
+    khash_t(stateIndex) * hash;
+};
+
+struct SymbolIndex {
+    khash_t(symbolIndex) * hash;
+};
+
+struct TransitionIndex {
+    khash_t(transitionIndex) * hash;
+};
+
+struct TransitionFunctionIndex {
+    khash_t(transitionFunction) * hash;
+};
+
+static inline khint64_t _transitionFunctionKey(unsigned int fromId, unsigned int symbolId) {
+    return ((khint64_t) fromId << 32) | symbolId;
+}
+
+/*----------------------------------------- KEYS ----------------------------------------------------*/
+unsigned int stateKey(const State * state) {
+    return (state->symbol.id << 2) | (state->isFinal << 1) | state->isInitial;
+}
+
+TransitionKey transitionKey(const Transition * transition) {
+    TransitionKey key = {
+        .from = stateKey(transition->fromExpression->state),
+        .symbol = transition->symbolExpression->symbol->id,
+        .to = stateKey(transition->toExpression->state)
+    };
+    return key;
+}
+
+/*----------------------------------------- STATE INDEX ----------------------------------------------------*/
+StateIndex * createStateIndex(void) {
+    StateIndex * index = calloc(1, sizeof(StateIndex));
+    index->hash = kh_init(stateIndex);
+    return index;
+}
+
+void destroyStateIndex(StateIndex * index) {
+    if (index != NULL) {
+        kh_destroy(stateIndex, index->hash);
+        free(index);
+    }
+}
+
+boolean addState(StateIndex * index, const State * state) {
+    countStatistic(INDEX_LOOKUPS, 1);
+    int ret;
+    kh_put(stateIndex, index->hash, stateKey(state), &ret);
+    return ret > 0;
+}
+
+boolean indexContainsState(const StateIndex * index, const State * state) {
+    countStatistic(INDEX_LOOKUPS, 1);
+    return kh_get(stateIndex, index->hash, stateKey(state)) != kh_end(index->hash);
+}
+
+/*----------------------------------------- SYMBOL INDEX ----------------------------------------------------*/
+SymbolIndex * createSymbolIndex(void) {
+    SymbolIndex * index = calloc(1, sizeof(SymbolIndex));
+    index->hash = kh_init(symbolIndex);
+    return index;
+}
+
+void destroySymbolIndex(SymbolIndex * index) {
+    if (index != NULL) {
+        kh_destroy(symbolIndex, index->hash);
+        free(index);
+    }
+}
+
+boolean addSymbol(SymbolIndex * index, const Symbol * symbol) {
+    countStatistic(INDEX_LOOKUPS, 1);
+    int ret;
+    kh_put(symbolIndex, index->hash, symbol->id, &ret);
+    return ret > 0;
+}
+
+boolean indexContainsSymbol(const SymbolIndex * index, const Symbol * symbol) {
+    countStatistic(INDEX_LOOKUPS, 1);
+    return kh_get(symbolIndex, index->hash, symbol->id) != kh_end(index->hash);
+}
+
+/*----------------------------------------- TRANSITION INDEX ----------------------------------------------------*/
+TransitionIndex * createTransitionIndex(void) {
+    TransitionIndex * index = calloc(1, sizeof(TransitionIndex));
+    index->hash = kh_init(transitionIndex);
+    return index;
+}
+
+void destroyTransitionIndex(TransitionIndex * index) {
+    if (index != NULL) {
+        kh_destroy(transitionIndex, index->hash);
+        free(index);
+    }
+}
+
+boolean addTransition(TransitionIndex * index, const Transition * transition) {
+    return addTransitionKey(index, transitionKey(transition));
+}
+
+boolean addTransitionKey(TransitionIndex * index, TransitionKey key) {
+    countStatistic(INDEX_LOOKUPS, 1);
+    int ret;
+    kh_put(transitionIndex, index->hash, key, &ret);
+    return ret > 0;
+}
+
+boolean indexContainsTransition(const TransitionIndex * index, const Transition * transition) {
+    countStatistic(INDEX_LOOKUPS, 1);
+    return kh_get(transitionIndex, index->hash, transitionKey(transition)) != kh_end(index->hash);
+}
+
+/*----------------------------------------- TRANSITION FUNCTION INDEX ----------------------------------------------------*/
+TransitionFunctionIndex * createTransitionFunctionIndex(void) {
+    TransitionFunctionIndex * index = calloc(1, sizeof(TransitionFunctionIndex));
+    index->hash = kh_init(transitionFunction);
+    return index;
+}
+
+void destroyTransitionFunctionIndex(TransitionFunctionIndex * index) {
+    if (index != NULL) {
+        kh_destroy(transitionFunction, index->hash);
+        free(index);
+    }
+}
+
+Transition * putTransitionFunction(TransitionFunctionIndex * index, Transition * transition) {
+    countStatistic(INDEX_LOOKUPS, 1);
+    int ret;
+    khint64_t key = _transitionFunctionKey(transition->fromExpression->state->symbol.id, transition->symbolExpression->symbol->id);
+    khiter_t k = kh_put(transitionFunction, index->hash, key, &ret);
+    if (ret > 0)
+        kh_value(index->hash, k) = transition;
+    return kh_value(index->hash, k);
+}
+
+Transition * transitionFunction(const TransitionFunctionIndex * index, unsigned int fromId, unsigned int symbolId) {
+    countStatistic(INDEX_LOOKUPS, 1);
+    khiter_t k = kh_get(transitionFunction, index->hash, _transitionFunctionKey(fromId, symbolId));
+    if (k == kh_end(index->hash))
+        return NULL;
+    return kh_value(index->hash, k);
+}
@@ -0,0 +1,62 @@
+#ifndef SET_INDEX_HEADER
+#define SET_INDEX_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Statistics.h"
+
+/**
+ * Hash indexes over the interned ids of states, symbols and transitions. They
+ * shadow the linked-list sets of the AST so membership and deduplication run
+ * in constant expected time per element.
+ */
+typedef struct StateIndex StateIndex;
+typedef struct SymbolIndex SymbolIndex;
+typedef struct TransitionIndex TransitionIndex;
+// TransitionFunctionIndex se declara en el AST, el automata lo conserva
+
+/**
+ * A transition packed as the triple of its (from, symbol, to) keys.
+ */
+typedef struct {
+    unsigned int from;
+    unsigned int symbol;
+    unsigned int to;
+} TransitionKey;
+
+/*----------------------------------------- KEYS ----------------------------------------------------*/
+// la clave de un estado incluye si es final / initial, igual que stateEquals
+unsigned int stateKey(const State * state);
+TransitionKey transitionKey(const Transition * transition);
+
+/*----------------------------------------- STATE INDEX ----------------------------------------------------*/
+StateIndex * createStateIndex(void);
+void destroyStateIndex(StateIndex * index);
+/** @return true si el estado no estaba en el indice */
+boolean addState(StateIndex * index, const State * state);
+boolean indexContainsState(const StateIndex * index, const State * state);
+
+/*----------------------------------------- SYMBOL INDEX ----------------------------------------------------*/
+SymbolIndex * createSymbolIndex(void);
+void destroySymbolIndex(SymbolIndex * index);
+/** @return true si el simbolo no estaba en el indice */
+boolean addSymbol(SymbolIndex * index, const Symbol * symbol);
+boolean indexContainsSymbol(const SymbolIndex * index, const Symbol * symbol);
+
+/*----------------------------------------- TRANSITION INDEX ----------------------------------------------------*/
+TransitionIndex * createTransitionIndex(void);
+void destroyTransitionIndex(TransitionIndex * index);
+/** @return true si la transicion no estaba en el indice */
+boolean addTransition(TransitionIndex * index, const Transition * transition);
+boolean addTransitionKey(TransitionIndex * index, TransitionKey key);
+boolean indexContainsTransition(const TransitionIndex * index, const Transition * transition);
+
+/*----------------------------------------- TRANSITION FUNCTION INDEX ----------------------------------------------------*/
+// (from, simbolo) -> transicion, sin importar si los estados son final / initial
+TransitionFunctionIndex * createTransitionFunctionIndex(void);
+void destroyTransitionFunctionIndex(TransitionFunctionIndex * index);
+/** @return la transicion que ya definia (from, simbolo), o la misma transicion si es la primera */
+Transition * putTransitionFunction(TransitionFunctionIndex * index, Transition * transition);
+/** @return la transicion de (from, simbolo), o NULL si no hay */
+Transition * transitionFunction(const TransitionFunctionIndex * index, unsigned int fromId, unsigned int symbolId);
+
+#endif
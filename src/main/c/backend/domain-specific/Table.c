@@ -13,32 +13,50 @@ KHASH_MAP_INIT_STR(myhash, Entry)
 
 khash_t(myhash) * hashTable;
 
+// muchos lectores o un solo escritor: las definiciones se computan en paralelo
+static ReadWriteLock _lock = READ_WRITE_LOCK_INITIALIZER;
+
 
 void initializeTable(void){
    hashTable = kh_init(myhash);
    _logger = createLogger("Table");
 }
 
-// EL CPY lo hace el usuario
+void shutdownTable(void){
+    kh_destroy(myhash, hashTable);
+    hashTable = NULL;
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+        _logger = NULL;
+    }
+}
+
+// El snapshot se comparte, el CPY lo hace el usuario solo si lo modifica
 EntryResult getValue(char * identifier, ValueType type){
     logInformation(_logger, "Getting value with identifier: %s...", identifier);
     EntryResult result = { .found=false} ;
+    lockForReading(&_lock);
     khiter_t k = kh_get(myhash, hashTable, identifier);
-    if ( k==kh_end(hashTable) )
+    if ( k==kh_end(hashTable) ) {
+        unlockReadWriteLock(&_lock);
         return result;
-    Entry entry = kh_value(hashTable,k);
-    if ( type == entry.type ) {
+    }
+    Entry * entry = &kh_value(hashTable,k);
+    if ( type == entry->type ) {
+        logDebugging(_logger, "Sharing %s", identifier);
         result.found=true, 
-        result.value=entry.value;
+        result.value=entry->value;
     }
+    unlockReadWriteLock(&_lock);
     return result;
 }
 
 boolean exists(char * identifier ) {
+    lockForReading(&_lock);
     khiter_t k = kh_get(myhash, hashTable, identifier);
-    if ( k==kh_end(hashTable) )
-        return false;
-    return true; 
+    const boolean found = k != kh_end(hashTable);
+    unlockReadWriteLock(&_lock);
+    return found;
 }
 
 
@@ -46,9 +64,12 @@ boolean insert(char * identifier,  ValueType type, Value value ){
     int ret;
     logWarning(_logger, "Inserting identifier: %s...", identifier);
 
+    lockForWriting(&_lock);
     khiter_t k = kh_put(myhash, hashTable, identifier, &ret);
-    if ( ret <= 0)
+    if ( ret <= 0) {
+        unlockReadWriteLock(&_lock);
         return false;
+    }
     logCritical(_logger, "Put key");
     Entry entry = {
         .type = type,
@@ -56,5 +77,6 @@ boolean insert(char * identifier,  ValueType type, Value value ){
     };
 
     kh_value(hashTable,k) = entry;
+    unlockReadWriteLock(&_lock);
     return true;
 }
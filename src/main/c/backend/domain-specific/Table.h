@@ -2,6 +2,7 @@
 #define TABLE_HEADER
 
 #include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Concurrency.h"
 
 
 typedef enum {
@@ -23,11 +24,15 @@ typedef struct{
     boolean found;
 } EntryResult;
 
+/* Las funciones de la tabla se pueden llamar desde varios hilos a la vez */
 void initializeTable(void);
 
+void shutdownTable(void);
+
 /**
- * @return Value que contiene ptr a lo buscado
- * es responsabilidad del cliente copiar el contenido del ptr
+ * @return Value que contiene ptr al snapshot buscado
+ * el snapshot es inmutable y se comparte entre todas las referencias:
+ * el cliente solo debe copiarlo (own*Set) si lo va a modificar
  */
 EntryResult getValue(char * identifier, ValueType type);
 
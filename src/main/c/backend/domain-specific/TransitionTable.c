@@ -0,0 +1,151 @@
+#include "TransitionTable.h"
+#include "khash.h"
+
+KHASH_MAP_INIT_INT(transitionTableIndex, unsigned int)
+
+struct TransitionTableIndex {
+    khash_t(transitionTableIndex) * hash;
+};
+
+/*----------------------------------------- PRIVATE FUNCTIONS ----------------------------------------------------*/
+static void _putIndex(TransitionTableIndex * index, const unsigned int id, const unsigned int position);
+static int _getIndex(const TransitionTableIndex * index, const unsigned int id);
+static void _countingSort(const unsigned int * keys, const unsigned int keysCount, const unsigned int * order, const unsigned int count, unsigned int * first, unsigned int * sorted);
+
+// queda el primero, como en la busqueda lineal
+static void _putIndex(TransitionTableIndex * index, const unsigned int id, const unsigned int position) {
+    int ret;
+    khiter_t k = kh_put(transitionTableIndex, index->hash, id, &ret);
+    if (0 < ret)
+        kh_value(index->hash, k) = position;
+}
+
+static int _getIndex(const TransitionTableIndex * index, const unsigned int id) {
+    khiter_t k = kh_get(transitionTableIndex, index->hash, id);
+    return k == kh_end(index->hash) ? -1 : (int) kh_value(index->hash, k);
+}
+
+/**
+ * Stable counting sort of the transitions in "order" by their key. Leaves in
+ * "first" the keysCount + 1 offsets where each key starts.
+ */
+static void _countingSort(const unsigned int * keys, const unsigned int keysCount, const unsigned int * order, const unsigned int count, unsigned int * first, unsigned int * sorted) {
+    memset(first, 0, (keysCount + 1) * sizeof(unsigned int));
+    for (unsigned int k = 0; k < count; ++k)
+        first[keys[k] + 1]++;
+    for (unsigned int key = 0; key < keysCount; ++key)
+        first[key + 1] += first[key];
+    unsigned int * next = malloc((keysCount == 0 ? 1 : keysCount) * sizeof(unsigned int));
+    memcpy(next, first, keysCount * sizeof(unsigned int));
+    for (unsigned int k = 0; k < count; ++k)
+        sorted[next[keys[order[k]]]++] = order[k];
+    free(next);
+}
+
+/*----------------------------------------- PUBLIC FUNCTIONS ----------------------------------------------------*/
+TransitionTable * createTransitionTable(State ** states, const unsigned int statesCount, Symbol ** symbols, const unsigned int symbolsCount, const TransitionSet * transitions) {
+    TransitionTable * table = calloc(1, sizeof(TransitionTable));
+    table->states = states;
+    table->statesCount = statesCount;
+    table->symbols = symbols;
+    table->symbolsCount = symbolsCount;
+
+    table->stateIndexes = malloc(sizeof(TransitionTableIndex));
+    table->stateIndexes->hash = kh_init(transitionTableIndex);
+    kh_resize(transitionTableIndex, table->stateIndexes->hash, statesCount);
+    for (unsigned int k = 0; k < statesCount; ++k)
+        _putIndex(table->stateIndexes, states[k]->symbol.id, k);
+    table->symbolIndexes = malloc(sizeof(TransitionTableIndex));
+    table->symbolIndexes->hash = kh_init(transitionTableIndex);
+    kh_resize(transitionTableIndex, table->symbolIndexes->hash, symbolsCount);
+    for (unsigned int k = 0; k < symbolsCount; ++k)
+        _putIndex(table->symbolIndexes, symbols[k]->id, k);
+
+    table->inDegree = calloc(statesCount == 0 ? 1 : statesCount, sizeof(unsigned int));
+    table->finalStates = createBitset(statesCount);
+    table->initialStates = createBitset(statesCount);
+    for (unsigned int k = 0; k < statesCount; ++k){
+        const int stateIndex = transitionTableStateIndex(table, states[k]->symbol.id);
+        if ( states[k]->isFinal )
+            setBit(table->finalStates, stateIndex);
+        if ( states[k]->isInitial )
+            setBit(table->initialStates, stateIndex);
+    }
+
+    for (TransitionNode * node = transitions->first; node != NULL; node = node->next)
+        table->transitionsCount++;
+    const unsigned int count = table->transitionsCount;
+    const size_t size = (count == 0 ? 1 : count) * sizeof(unsigned int);
+    unsigned int * sources = malloc(size);
+    unsigned int * symbolIndexes = malloc(size);
+    unsigned int * targets = malloc(size);
+    unsigned int k = 0;
+    for (TransitionNode * node = transitions->first; node != NULL; node = node->next, ++k) {
+        const Transition * transition = node->transition;
+        sources[k] = transitionTableStateIndex(table, transition->fromExpression->state->symbol.id);
+        symbolIndexes[k] = transitionTableSymbolIndex(table, transition->symbolExpression->symbol->id);
+        targets[k] = transitionTableStateIndex(table, transition->toExpression->state->symbol.id);
+        table->inDegree[targets[k]]++;
+    }
+
+    // por simbolo y despues por origen: como las dos son estables, cada fila
+    // queda ordenada por simbolo y los destinos de un simbolo en el orden del set
+    unsigned int * order = malloc(size);
+    unsigned int * bySymbol = malloc(size);
+    unsigned int * symbolFirst = malloc((symbolsCount + 1) * sizeof(unsigned int));
+    for (k = 0; k < count; ++k)
+        order[k] = k;
+    _countingSort(symbolIndexes, symbolsCount, order, count, symbolFirst, bySymbol);
+    table->firstTransition = malloc((statesCount + 1) * sizeof(unsigned int));
+    _countingSort(sources, statesCount, bySymbol, count, table->firstTransition, order);
+
+    table->transitionSymbols = malloc(size);
+    table->transitionTargets = malloc(size);
+    for (k = 0; k < count; ++k) {
+        table->transitionSymbols[k] = symbolIndexes[order[k]];
+        table->transitionTargets[k] = targets[order[k]];
+    }
+    free(symbolFirst);
+    free(bySymbol);
+    free(order);
+    free(targets);
+    free(symbolIndexes);
+    free(sources);
+    return table;
+}
+
+void destroyTransitionTable(TransitionTable * table) {
+    if (table != NULL) {
+        kh_destroy(transitionTableIndex, table->stateIndexes->hash);
+        free(table->stateIndexes);
+        kh_destroy(transitionTableIndex, table->symbolIndexes->hash);
+        free(table->symbolIndexes);
+        free(table->firstTransition);
+        free(table->transitionSymbols);
+        free(table->transitionTargets);
+        free(table->inDegree);
+        destroyBitset(table->finalStates);
+        destroyBitset(table->initialStates);
+        free(table);
+    }
+}
+
+int transitionTableStateIndex(const TransitionTable * table, const unsigned int stateId) {
+    return _getIndex(table->stateIndexes, stateId);
+}
+
+boolean transitionTableHasTransitions(const TransitionTable * table, const int stateIndex) {
+    return 0 <= stateIndex && (0 < transitionTableOutDegree(table, stateIndex) || 0 < table->inDegree[stateIndex]);
+}
+
+boolean transitionTableIsFinal(const TransitionTable * table, const int stateIndex) {
+    return 0 <= stateIndex && testBit(table->finalStates, stateIndex);
+}
+
+boolean transitionTableIsInitial(const TransitionTable * table, const int stateIndex) {
+    return 0 <= stateIndex && testBit(table->initialStates, stateIndex);
+}
+
+int transitionTableSymbolIndex(const TransitionTable * table, const unsigned int symbolId) {
+    return _getIndex(table->symbolIndexes, symbolId);
+}
@@ -0,0 +1,68 @@
+#ifndef TRANSITION_TABLE_HEADER
+#define TRANSITION_TABLE_HEADER
+
+#include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../shared/Type.h"
+#include "Bitset.h"
+#include <stdlib.h>
+#include <string.h>
+
+// de id interno a indice en los arreglos del automata
+typedef struct TransitionTableIndex TransitionTableIndex;
+
+/**
+ * The transitions of an automata in compressed sparse rows, over the indexes
+ * of its states and symbols (their positions in the specified arrays). There
+ * is one row per state: the transitions of the state with index s are
+ * firstTransition[s] .. firstTransition[s + 1] - 1, and each one is the pair
+ * (transitionSymbols[k], transitionTargets[k]) of a symbol index and a target
+ * state index. A row is ordered by symbol, and the targets of one symbol keep
+ * the order of the transition set. It's built once per automata, and read by
+ * the generator and any other pass that walks the transitions. It also keeps
+ * the in degree of every state, and which states are final or initial (a state
+ * id is final if any state with that id is).
+ */
+typedef struct {
+    State ** states;
+    unsigned int statesCount;
+    Symbol ** symbols;
+    unsigned int symbolsCount;
+    unsigned int transitionsCount;
+    unsigned int * firstTransition;
+    unsigned int * transitionSymbols;
+    unsigned int * transitionTargets;
+    unsigned int * inDegree;
+    Bitset * finalStates;
+    Bitset * initialStates;
+    TransitionTableIndex * stateIndexes;
+    TransitionTableIndex * symbolIndexes;
+} TransitionTable;
+
+/**
+ * Builds the table with two stable counting sorts (by symbol, then by source
+ * state), in O(T + S + A) time and space. The table keeps the arrays, but
+ * doesn't own them. Every state and symbol of the transitions must be in the
+ * arrays.
+ */
+TransitionTable * createTransitionTable(State ** states, const unsigned int statesCount, Symbol ** symbols, const unsigned int symbolsCount, const TransitionSet * transitions);
+
+void destroyTransitionTable(TransitionTable * table);
+
+/** @return el indice del estado con ese id, o -1 si no esta en la tabla */
+int transitionTableStateIndex(const TransitionTable * table, const unsigned int stateId);
+
+/** @return el indice del simbolo con ese id, o -1 si no esta en la tabla */
+int transitionTableSymbolIndex(const TransitionTable * table, const unsigned int symbolId);
+
+/** @return true si el estado es origen o destino de alguna transicion */
+boolean transitionTableHasTransitions(const TransitionTable * table, const int stateIndex);
+
+boolean transitionTableIsFinal(const TransitionTable * table, const int stateIndex);
+boolean transitionTableIsInitial(const TransitionTable * table, const int stateIndex);
+
+/** @return la cantidad de transiciones que salen del estado */
+static inline unsigned int transitionTableOutDegree(const TransitionTable * table, const unsigned int stateIndex) {
+    return table->firstTransition[stateIndex + 1] - table->firstTransition[stateIndex];
+}
+
+#endif
@@ -3,10 +3,17 @@
 static Logger * _logger = NULL;
 
 
-void initializeLogger(void){
+void initializeUtilsModule(void){
    _logger = createLogger("utils");
 }
 
+void shutdownUtilsModule(void){
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+        _logger = NULL;
+    }
+}
+
 /*----------------------------------------- SET CONTAINS ----------------------------------------------------*/ 
 boolean containsState(StateNode *first, State * state ) {
     StateNode * currentNode = first;
@@ -24,32 +31,23 @@ boolean containsState(StateNode *first, State * state ) {
 boolean containsSymbol(SymbolNode *first, Symbol * s ) {
     SymbolNode * currentNode = first;
     while ( currentNode != NULL ){
-    //    initializeLogger();
-    //    logCritical(_logger,"Symbol node %s", currentNode->symbol->value );
-    //    logCritical(_logger,"Symbol compared %s", s->value );
-    
         if ( symbolEquals(s,currentNode->symbol) ) {
             return true; 
         }
-    //    logCritical(_logger,"---Post equals---" );    
-    //    logCritical(_logger,"Symbol node %s", currentNode->symbol->value );
-    //    logCritical(_logger,"Symbol compared %s", s->value );
-            
         currentNode = currentNode->next; 
     }
     return false;
 }
 
 /*----------------------------------------- COPY SET ----------------------------------------------------*/ 
-SymbolSet * cpySymbolSet(SymbolSet * set) {
+SymbolSet * cpySymbolSet(SymbolSet * set, Arena * arena) {
     SymbolNode * currentNode = set->first;
-    SymbolNode * resultTail;
+    SymbolNode * resultTail = NULL;
     SymbolNode * node;
-    SymbolSet * resultSet = calloc(1,sizeof(SymbolSet));
+    SymbolSet * resultSet = allocateFromArena(arena, sizeof(SymbolSet));
     while ( currentNode != NULL ){
-        node = calloc(1,sizeof(SymbolNode));
-        node->symbol = calloc(1,sizeof(Symbol));
-        node->symbol->value = currentNode->symbol->value; 
+        node = allocateFromArena(arena, sizeof(SymbolNode));
+        node->symbol = currentNode->symbol;
         node->type = ELEMENT;
         if ( resultSet->first==NULL )
             resultSet->first = node;
@@ -63,19 +61,15 @@ SymbolSet * cpySymbolSet(SymbolSet * set) {
     return resultSet;
 }
 
-StateSet * cpyStateSet(StateSet * set){
+StateSet * cpyStateSet(StateSet * set, Arena * arena){
     StateNode * currentNode = set->first;
     StateNode * resultTail = NULL;
     StateNode * node;
-    initializeLogger();
-    logInformation(_logger,"copying..");
-    StateSet * resultSet = calloc(1,sizeof(StateSet));
+    logDebugging(_logger,"copying..");
+    StateSet * resultSet = allocateFromArena(arena, sizeof(StateSet));
     while ( currentNode != NULL ){
-        node = calloc(1,sizeof(StateNode));
-        node->state = calloc(1,sizeof(State));
-        node->state->symbol = currentNode->state->symbol;   
-        node->state->isFinal = currentNode->state->isFinal;
-        node->state->isInitial = currentNode->state->isInitial;
+        node = allocateFromArena(arena, sizeof(StateNode));
+        node->state = currentNode->state;     // los estados son inmutables, se comparten
         node->type = ELEMENT;
         if ( resultSet->first==NULL )
             resultSet->first = node;
@@ -91,15 +85,15 @@ StateSet * cpyStateSet(StateSet * set){
 
 }
 
-TransitionSet * cpyTransitionSet(TransitionSet * set){
+TransitionSet * cpyTransitionSet(TransitionSet * set, Arena * arena){
     TransitionNode * currentNode = set->first;
-    TransitionNode * resultTail;
+    TransitionNode * resultTail = NULL;
     TransitionNode * node;
-    TransitionSet * resultSet = calloc(1,sizeof(TransitionSet));
+    TransitionSet * resultSet = allocateFromArena(arena, sizeof(TransitionSet));
     while ( currentNode != NULL ){
-        node = calloc(1,sizeof(TransitionNode));
+        node = allocateFromArena(arena, sizeof(TransitionNode));
         node->transition = currentNode->transition;
-        node->type = ELEMENT;
+        node->type = currentNode->type;      // puede ser un producto sin expandir
         if ( resultSet->first==NULL )
             resultSet->first = node;
         else 
@@ -113,6 +107,54 @@ TransitionSet * cpyTransitionSet(TransitionSet * set){
 }
 
 
+/*----------------------------------------- COPY ON WRITE ----------------------------------------------------*/ 
+void shareSymbolSet(SymbolSet * set, const SymbolSet * snapshot){
+    set->first = snapshot->first;
+    set->tail = snapshot->tail;
+    set->isShared = true;
+}
+
+void shareStateSet(StateSet * set, const StateSet * snapshot){
+    set->first = snapshot->first;
+    set->tail = snapshot->tail;
+    set->isShared = true;
+}
+
+void shareTransitionSet(TransitionSet * set, const TransitionSet * snapshot){
+    set->first = snapshot->first;
+    set->tail = snapshot->tail;
+    set->isShared = true;
+}
+
+/* Copia los nodos compartidos antes de que el set se modifique */
+void ownSymbolSet(SymbolSet * set, Arena * arena){
+    if ( !set->isShared )
+        return;
+    SymbolSet * copy = cpySymbolSet(set, arena);
+    set->first = copy->first;
+    set->tail = copy->tail;
+    set->isShared = false;
+}
+
+void ownStateSet(StateSet * set, Arena * arena){
+    if ( !set->isShared )
+        return;
+    StateSet * copy = cpyStateSet(set, arena);
+    set->first = copy->first;
+    set->tail = copy->tail;
+    set->isShared = false;
+}
+
+void ownTransitionSet(TransitionSet * set, Arena * arena){
+    if ( !set->isShared )
+        return;
+    TransitionSet * copy = cpyTransitionSet(set, arena);
+    set->first = copy->first;
+    set->tail = copy->tail;
+    set->isShared = false;
+}
+
+
 /*----------------------------------------- SET EQUALS ----------------------------------------------------*/ 
  boolean transitionSetEquals(TransitionSet * set1, TransitionSet * set2){
     TransitionNode * current1 = set1->first;
@@ -262,39 +304,6 @@ TransitionSet * cpyTransitionSet(TransitionSet * set){
 }
 
  boolean symbolEquals(const Symbol * symbol1,const Symbol * symbol2){
-    return strcmp(symbol1->value, symbol2->value) == 0;
-}
-
-/*-------------------------------------- FREE NODE SETS --------------------*/
-void freeTransitionSet(TransitionSet * set){
-    TransitionNode * current = set->first;
-    TransitionNode * next;
-    while (current != NULL){
-        next = current->next;
-        free(current);
-        current = next;
-    }
-    free(set);
-}
-
-void freeStateSet(StateSet * set){
-    StateNode * current = set->first;
-    StateNode * next;
-    while (current != NULL){
-        next = current->next;
-        free(current);
-        current = next;
-    }
-    free(set);
+    countStatistic(ELEMENT_COMPARISONS, 1);
+    return symbol1->id == symbol2->id;
 }
-
-void freeSymbolSet(SymbolSet * set){
-    SymbolNode * current = set->first;
-    SymbolNode * next;
-    while (current != NULL){
-        next = current->next;
-        free(current);
-        current = next;
-    }
-    free(set);
-} 
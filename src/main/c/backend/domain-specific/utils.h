@@ -3,21 +3,32 @@
 
 
 #include "../../frontend/syntactic-analysis/AbstractSyntaxTree.h"
+#include "../../frontend/syntactic-analysis/SymbolPool.h"
+#include "../../shared/Arena.h"
+#include "../../shared/Logger.h"
+
+/* El logger del modulo se crea una sola vez (lo inicializa Automatex) */
+void initializeUtilsModule(void);
+void shutdownUtilsModule(void);
 
 /*----------------------------------------- SET CONTAINS ----------------------------------------------------*/ 
 boolean containsState(StateNode *first, State * state );
 boolean containsSymbol( SymbolNode *first, Symbol * symbol );
 
 /*----------------------------------------- COPY SET ----------------------------------------------------*/ 
-SymbolSet * cpySymbolSet(SymbolSet * symbolSet);
-StateSet * cpyStateSet(StateSet * StateSet);
-TransitionSet * cpyTransitionSet(TransitionSet * StateSet);
-
+SymbolSet * cpySymbolSet(SymbolSet * symbolSet, Arena * arena);
+StateSet * cpyStateSet(StateSet * StateSet, Arena * arena);
+TransitionSet * cpyTransitionSet(TransitionSet * StateSet, Arena * arena);
+
+/*----------------------------------------- COPY ON WRITE ----------------------------------------------------*/ 
+/* Los sets que referencian un snapshot de la tabla comparten sus nodos (isShared) hasta que se modifican */
+void shareSymbolSet(SymbolSet * set, const SymbolSet * snapshot);
+void shareStateSet(StateSet * set, const StateSet * snapshot);
+void shareTransitionSet(TransitionSet * set, const TransitionSet * snapshot);
+void ownSymbolSet(SymbolSet * set, Arena * arena);
+void ownStateSet(StateSet * set, Arena * arena);
+void ownTransitionSet(TransitionSet * set, Arena * arena);
 
-/*-------------------------------------- FREE NODE SETS --------------------*/
-void freeTransitionSet(TransitionSet * set);
-void freeStateSet(StateSet * set);
-void freeSymbolSet(SymbolSet * set);
 
 /*----------------------------------------- SET EQUALS ----------------------------------------------------*/ 
 boolean transitionSetEquals(TransitionSet * set1, TransitionSet * set2);
@@ -19,12 +19,26 @@ void shutdownFlexActionsModule() {
 
 /* PRIVATE FUNCTIONS */
 
+static char * _copyLexeme(LexicalAnalyzerContext * lexicalAnalyzerContext);
 static void _logLexicalAnalyzerContext(const char * functionName, LexicalAnalyzerContext * lexicalAnalyzerContext);
 
+/**
+ * Copies the lexeme into the arena of the compilation, for the lexemes that
+ * reach the AST (the context only holds a slice of the scanner's buffer).
+ */
+static char * _copyLexeme(LexicalAnalyzerContext * lexicalAnalyzerContext) {
+	char * lexeme = allocateFromArena(lexicalAnalyzerContext->compilerState->arena, 1 + lexicalAnalyzerContext->length);
+	memcpy(lexeme, lexicalAnalyzerContext->lexeme, lexicalAnalyzerContext->length);
+	return lexeme;
+}
+
 /**
  * Logs a lexical-analyzer context in DEBUGGING level.
  */
 static void _logLexicalAnalyzerContext(const char * functionName, LexicalAnalyzerContext * lexicalAnalyzerContext) {
+	if (!isLoggingEnabled(_logger, DEBUGGING)) {
+		return;
+	}
 	char * escapedLexeme = escape(lexicalAnalyzerContext->lexeme);
 	logDebugging(_logger, "%s: %s (context = %d, length = %d, line = %d)",
 		functionName,
@@ -163,13 +177,13 @@ Token StateTypeLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext, Tok
 
 Token SymbolLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
 	_logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
-	lexicalAnalyzerContext->semanticValue->value = lexicalAnalyzerContext->lexeme;
+	lexicalAnalyzerContext->semanticValue->symbol = internSymbol(lexicalAnalyzerContext->lexeme);
 	return SYMBOL;
 }
 
 Token IdentifierLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext) {
 	_logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
-	lexicalAnalyzerContext->semanticValue->value = lexicalAnalyzerContext->lexeme;
+	lexicalAnalyzerContext->semanticValue->value = _copyLexeme(lexicalAnalyzerContext);
 	return IDENTIFIER;
 }
 
@@ -7,6 +7,7 @@
 #include "../../shared/Type.h"
 #include "../syntactic-analysis/AbstractSyntaxTree.h"
 #include "../syntactic-analysis/BisonParser.h"
+#include "../syntactic-analysis/SymbolPool.h"
 #include "LexicalAnalyzerContext.h"
 #include <stdio.h>
 #include <stdlib.h>
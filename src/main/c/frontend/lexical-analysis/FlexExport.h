@@ -2,12 +2,72 @@
 #define FLEX_EXPORT_HEADER
 
 /**
- * Hook that allows to export a static function or variable from the inside of
- * Flex infrastructure, in this case, the current context (a.k.a. start
- * condition).
+ * Hooks that export the Flex infrastructure. The scanner is reentrant, so
+ * every hook receives it (as an opaque pointer), and its state is only
+ * reachable from the inside of this file.
+ *
+ * @see https://westes.github.io/flex/manual/Reentrant.html
  */
-unsigned int flexCurrentContext(void) {
+
+/**
+ * Creates a scanner that reads from the standard input, with the specified
+ * context as its "extra" data. Returns NULL on failure.
+ */
+void * flexCreateScanner(LexicalAnalyzerContext * lexicalAnalyzerContext) {
+	yyscan_t scanner;
+	if (yylex_init_extra(lexicalAnalyzerContext, &scanner) != 0) {
+		return NULL;
+	}
+	return scanner;
+}
+
+/**
+ * Destroys a scanner and its buffers (but not the memory they scan, nor its
+ * context).
+ */
+void flexDestroyScanner(void * scanner) {
+	yylex_destroy((yyscan_t) scanner);
+}
+
+/**
+ * Makes the scanner read an in-memory buffer instead of the standard input,
+ * without copying it. The size includes the two trailing zero bytes that Flex
+ * needs at the end of the buffer. Returns false if Flex rejects the buffer
+ * (because those bytes are missing), and then the scanner has no buffer.
+ *
+ * @see https://westes.github.io/flex/manual/Multiple-Input-Buffers.html
+ */
+boolean flexScanBuffer(void * scanner, char * buffer, const size_t size) {
+	return yy_scan_buffer(buffer, size, (yyscan_t) scanner) != NULL;
+}
+
+/**
+ * Sets the line of the next lexeme (the first one is on line 1). It must be
+ * called after every "flexScanBuffer", even for a buffer that starts on line
+ * 1: "yy_scan_buffer" doesn't set the line of the buffer it creates, and
+ * "yylineno" counts from there.
+ */
+void flexSetLine(void * scanner, const unsigned int line) {
+	yyset_lineno((int) line, (yyscan_t) scanner);
+}
+
+/**
+ * The current context (a.k.a. start condition) of the scanner.
+ */
+unsigned int flexCurrentContext(void * scanner) {
+	struct yyguts_t * yyg = (struct yyguts_t *) scanner;
 	return YY_START;
 }
 
+LexicalAnalyzerContext * currentLexicalAnalyzerContext(void * scanner) {
+	struct yyguts_t * yyg = (struct yyguts_t *) scanner;
+	LexicalAnalyzerContext * lexicalAnalyzerContext = yyextra;
+	lexicalAnalyzerContext->length = yyleng;
+	lexicalAnalyzerContext->lexeme = yytext;
+	lexicalAnalyzerContext->line = yylineno;
+	lexicalAnalyzerContext->semanticValue = yylval;
+	lexicalAnalyzerContext->currentContext = YY_START;
+	return lexicalAnalyzerContext;
+}
+
 #endif
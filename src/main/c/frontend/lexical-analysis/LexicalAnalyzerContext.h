@@ -1,30 +1,44 @@
 #ifndef LEXICAL_ANALYZER_CONTEXT_HEADER
 #define LEXICAL_ANALYZER_CONTEXT_HEADER
 
+#include "../../shared/CompilerState.h"
 #include <stdlib.h>
 #include <string.h>
 
 /**
- * The state of a lexical-analyzer context.
+ * The state of a lexical-analyzer context. The lexeme is a slice of the
+ * scanner's buffer, not a copy: it's only valid until the next lexeme is
+ * consumed, so any action that keeps it must copy it.
+ *
+ * Every scanner owns one context (its "extra" data), that is reused for every
+ * lexeme, and that knows the compilation it works for.
  */
 typedef struct {
 	unsigned int currentContext;
 	unsigned int length;
-	char * lexeme;
+	const char * lexeme;
 	unsigned int line;
 	union SemanticValue * semanticValue;
+	CompilerState * compilerState;
 } LexicalAnalyzerContext;
 
 /**
- * Creates a new context with the current state of the lexical-analyzer over
- * the lexeme just consumed. The lexeme is a deep-copy of the original,
- * allocated in heap-memory.
+ * Creates the context of a new scanner, that works for the specified
+ * compilation.
  */
-LexicalAnalyzerContext * createLexicalAnalyzerContext();
+LexicalAnalyzerContext * createLexicalAnalyzerContext(CompilerState * compilerState);
 
 /**
  * Destroy a lexical-analyzer context and its resources.
  */
 void destroyLexicalAnalyzerContext(LexicalAnalyzerContext * lexicalAnalyzerContext);
 
+/**
+ * Updates the context of the scanner with its current state over the lexeme
+ * just consumed, and returns it. Never allocates memory.
+ *
+ * Implemented inside the Flex scanner (see "FlexExport.h").
+ */
+LexicalAnalyzerContext * currentLexicalAnalyzerContext(void * scanner);
+
 #endif
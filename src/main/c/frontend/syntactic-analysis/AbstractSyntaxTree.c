@@ -1,5 +1,10 @@
 #include "AbstractSyntaxTree.h"
 
+/*
+ * Every node of the AST is allocated in the arena of the compilation (see
+ * CompilerState), which is released at once when the compilation ends.
+ */
+
 /* MODULE INTERNAL STATE */
 
 static Logger * _logger = NULL;
@@ -13,66 +18,3 @@ void shutdownAbstractSyntaxTreeModule() {
 		destroyLogger(_logger);
 	}
 }
-
-/** PUBLIC FUNCTIONS */
-
-
-void releaseStateSet(StateSet * stateSet){
-	logDebugging(_logger, "Executing destructor: %s", __FUNCTION__);
-	if ( stateSet != NULL ){
-		StateNode * stateNode = stateSet->first;
-		/*
-		while ( stateNode != NULL ){
-			releaseStateExpression(stateNode->expression);
-			currentDefinition = currentDefinition->next;
-		}
-		
-		free(definitionNode);*/
-	}
-}
-
-// todo 
-void releaseDefinition(Definition * definition) {
-	logDebugging(_logger, "Executing destructor: %s", __FUNCTION__);
-	if (definition != NULL) {
-		switch (definition->type)
-		{
-		case STATE_DEFINITION:
-			//releaseStateSet(definition->stateSet);
-			break;
-		case ALPHABET_DEFINITION:
-			//releaseAlphabet(definition->symbolSet);
-			break;
-		case TRANSITION_DEFINITION:
-			//releaseTransitionSet(definition->transitionSet);
-			break;
-		default:	// automata
-			break;
-		}
- 		free(definition);
-	}
-}
-
-void releaseDefinitionNode(DefinitionNode * definitionNode) {
-	logDebugging(_logger, "Executing destructor: %s", __FUNCTION__);
-	if (definitionNode != NULL) {
-		releaseDefinition(definitionNode->definition);	
-		free(definitionNode);
-	}
-}
-
-void releaseDefinitionSet(DefinitionSet * definitionSet) {
-	logDebugging(_logger, "Executing destructor: %s", __FUNCTION__);
-	if (definitionSet != NULL) {
-		DefinitionNode * currentDefinitionNode = definitionSet->first;
-		while ( currentDefinitionNode != NULL ){							//!= definitionSet->tail
-			releaseDefinitionNode(currentDefinitionNode);
-			currentDefinitionNode = currentDefinitionNode->next;
-		}
-//		if ( definitionSet->tail != NULL )
-//			releaseDefinitionNode(currentDefinitionNode);
-
-		free(definitionSet);
-	}
-}
-
@@ -41,6 +41,7 @@ typedef struct SymbolExpression SymbolExpression;
 typedef struct StateExpression StateExpression;
 typedef struct DefinitionSet DefinitionSet;
 typedef struct DefinitionNode DefinitionNode;
+typedef struct TransitionFunctionIndex TransitionFunctionIndex;
 
 /**
  * Node types for the Abstract Syntax Tree (AST).
@@ -72,7 +73,9 @@ enum ExpressionType {
 
 enum NodeType {
 	EXPRESSION,
-	ELEMENT
+	ELEMENT,
+	// A transition whose sides are sets: the cartesian product, not expanded yet.
+	PRODUCT
 };
 
 enum AutomataType {
@@ -124,6 +127,13 @@ struct Automata {
 	SymbolExpression* alphabet;
 	TransitionExpression* transitions; 
 	AutomataType automataType;
+	// The (from, symbol) -> transition index built while validating a DFA (NULL otherwise).
+	TransitionFunctionIndex * transitionFunction;
+	// The computed states and symbols in contiguous arrays (in the order of their sets).
+	State ** stateArray;
+	unsigned int stateCount;
+	Symbol ** symbolArray;
+	unsigned int symbolCount;
 };
 
 
@@ -173,6 +183,7 @@ struct SymbolSet {
 	SymbolNode * tail;
 	boolean isFromAutomata;
 	char * identifier;
+	boolean isShared;
 };
 
 struct StateSet {
@@ -181,6 +192,7 @@ struct StateSet {
 	char * identifier;
 	boolean isFromAutomata;
 	StateType stateType;
+	boolean isShared;
 };
 
 struct TransitionSet {
@@ -189,6 +201,7 @@ struct TransitionSet {
 	char * identifier;
 	boolean isFromAutomata;
 	boolean isBothSidesTransition;	
+	boolean isShared;
 };
 
 
@@ -229,6 +242,7 @@ struct TransitionNode {
 
 struct Symbol {
 	char * value;
+	unsigned int id;
 };	
 
 struct State {
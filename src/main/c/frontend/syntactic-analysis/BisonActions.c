@@ -16,12 +16,21 @@ void shutdownBisonActionsModule() {
 
 /** IMPORTED FUNCTIONS */
 
-extern unsigned int flexCurrentContext(void);
+extern unsigned int flexCurrentContext(void * scanner);
 
 /* PRIVATE FUNCTIONS */
 
+static void * _allocate(CompilerState * compilerState, const size_t size);
 static void _logSyntacticAnalyzerAction(const char * functionName);
 
+/**
+ * Reserves zero-filled memory for an AST node, in the arena of the
+ * compilation.
+ */
+static void * _allocate(CompilerState * compilerState, const size_t size) {
+	return allocateFromArena(compilerState->arena, size);
+}
+
 /**
  * Logs a syntactic-analyzer action in DEBUGGING level.
  */
@@ -31,21 +40,19 @@ static void _logSyntacticAnalyzerAction(const char * functionName) {
 
 /* ----------------------------------------------- DEFINITION SET ----------------------------------------------- */
 
-DefinitionSet * DefinitionSetSemanticAction(Definition * definition1, DefinitionSet * set2) {
+DefinitionSet * DefinitionSetSemanticAction(CompilerState * compilerState, DefinitionSet * set, Definition * definition) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	DefinitionSet * set = calloc(1, sizeof(DefinitionSet));
-	DefinitionNode * node = calloc(1, sizeof(DefinitionNode));
-	node->definition = definition1;
-	node->next = set2->first;
-	set->first = node;
-	set->tail = set2->tail;
+	DefinitionNode * node = _allocate(compilerState, sizeof(DefinitionNode));
+	node->definition = definition;
+	set->tail->next = node;
+	set->tail = node;
 	return set;
 }
 
-DefinitionSet * SingularDefinitionSetSemanticAction(Definition * definition) {
+DefinitionSet * SingularDefinitionSetSemanticAction(CompilerState * compilerState, Definition * definition) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	DefinitionSet * set = calloc(1, sizeof(DefinitionSet));
-	DefinitionNode * node = calloc(1, sizeof(DefinitionNode));
+	DefinitionSet * set = _allocate(compilerState, sizeof(DefinitionSet));
+	DefinitionNode * node = _allocate(compilerState, sizeof(DefinitionNode));
 	node->definition = definition;
 	set->first = node;
 	set->tail = node;
@@ -55,60 +62,60 @@ DefinitionSet * SingularDefinitionSetSemanticAction(Definition * definition) {
 /* ------------------------------------------------- DEFINITION ------------------------------------------------- */
 
 
-Definition * StateSetDefinitionSemanticAction(char * identifier, StateSet * set) {
+Definition * StateSetDefinitionSemanticAction(CompilerState * compilerState, char * identifier, StateSet * set) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Definition * definition = calloc(1, sizeof(Definition));
+	Definition * definition = _allocate(compilerState, sizeof(Definition));
 	set->identifier = identifier;
 	definition->stateSet = set;
 	definition->type = STATE_DEFINITION;
 	return definition;
 }
 
-Definition * SingularStateSetDefinitionSemanticAction(char * identifier, State* state) {
+Definition * SingularStateSetDefinitionSemanticAction(CompilerState * compilerState, char * identifier, State* state) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	StateExpression * stateExpression = SingularStateExpressionSemanticAction(state);
-	StateNode * first = SingularExpressionStateNodeSemanticAction(stateExpression);
-	StateSet * set = NodeStateSetSemanticAction(first);	
-	return StateSetDefinitionSemanticAction(identifier, set);
+	StateExpression * stateExpression = SingularStateExpressionSemanticAction(compilerState, state);
+	StateNode * first = SingularExpressionStateNodeSemanticAction(compilerState, stateExpression);
+	StateSet * set = NodeStateSetSemanticAction(compilerState, first);	
+	return StateSetDefinitionSemanticAction(compilerState, identifier, set);
 }
 
-Definition * SymbolSetDefinitionSemanticAction(char * identifier, SymbolSet * set) {
+Definition * SymbolSetDefinitionSemanticAction(CompilerState * compilerState, char * identifier, SymbolSet * set) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Definition * definition = calloc(1, sizeof(Definition));
+	Definition * definition = _allocate(compilerState, sizeof(Definition));
 	set->identifier = identifier;
 	definition->symbolSet = set;
 	definition->type = ALPHABET_DEFINITION;
 	return definition;
 }
 
-Definition * SingularSymbolSetDefinitionSemanticAction(char * identifier, Symbol * symbol) {
+Definition * SingularSymbolSetDefinitionSemanticAction(CompilerState * compilerState, char * identifier, Symbol * symbol) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	SymbolExpression* symbolExpression = SingularSymbolExpressionSemanticAction(symbol);
-	SymbolNode * first = SingularExpressionSymbolNodeSemanticAction(symbolExpression);
-	SymbolSet * set = NodeSymbolSetSemanticAction(first);		
-	return SymbolSetDefinitionSemanticAction(identifier, set);
+	SymbolExpression* symbolExpression = SingularSymbolExpressionSemanticAction(compilerState, symbol);
+	SymbolNode * first = SingularExpressionSymbolNodeSemanticAction(compilerState, symbolExpression);
+	SymbolSet * set = NodeSymbolSetSemanticAction(compilerState, first);		
+	return SymbolSetDefinitionSemanticAction(compilerState, identifier, set);
 }
 
-Definition * TransitionSetDefinitionSemanticAction(char * identifier, TransitionSet * set) {
+Definition * TransitionSetDefinitionSemanticAction(CompilerState * compilerState, char * identifier, TransitionSet * set) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Definition * definition = calloc(1, sizeof(Definition));
+	Definition * definition = _allocate(compilerState, sizeof(Definition));
 	set->identifier = identifier;
 	definition->transitionSet = set;
 	definition->type = TRANSITION_DEFINITION;
 	return definition;
 }
 
-Definition * SingularTransitionSetDefinitionSemanticAction(char * identifier, Transition * transition){
+Definition * SingularTransitionSetDefinitionSemanticAction(CompilerState * compilerState, char * identifier, Transition * transition){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	TransitionExpression * transitionExpression = SingularTransitionExpressionSemanticAction(transition);
-	TransitionNode * first = SingularExpressionTransitionNodeSemanticAction(transitionExpression);
-	TransitionSet * set = NodeTransitionSetSemanticAction(first);
-	return TransitionSetDefinitionSemanticAction(identifier, set);
+	TransitionExpression * transitionExpression = SingularTransitionExpressionSemanticAction(compilerState, transition);
+	TransitionNode * first = SingularExpressionTransitionNodeSemanticAction(compilerState, transitionExpression);
+	TransitionSet * set = NodeTransitionSetSemanticAction(compilerState, first);
+	return TransitionSetDefinitionSemanticAction(compilerState, identifier, set);
 }
 
-Definition * AutomataDefinitionSemanticAction(AutomataType type, char * identifier, Automata * automata ) {
+Definition * AutomataDefinitionSemanticAction(CompilerState * compilerState, AutomataType type, char * identifier, Automata * automata) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Definition * definition = calloc(1, sizeof(Definition));
+	Definition * definition = _allocate(compilerState, sizeof(Definition));
 	automata->identifier = identifier;
 	automata->automataType = type;
 	definition->automata = automata;
@@ -116,60 +123,60 @@ Definition * AutomataDefinitionSemanticAction(AutomataType type, char * identifi
 	return definition;
 }
 
-Definition * TransitionExpressionDefinitionSemanticAction(char * identifier,TransitionExpression * transitionExpression){
+Definition * TransitionExpressionDefinitionSemanticAction(CompilerState * compilerState, char * identifier,TransitionExpression * transitionExpression){
 	TransitionNode * first;
 	TransitionSet * set;
 	if ( transitionExpression->type != SET_EXPRESSION) {
-		first = SingularExpressionTransitionNodeSemanticAction(transitionExpression);
-		set = NodeTransitionSetSemanticAction(first);
+		first = SingularExpressionTransitionNodeSemanticAction(compilerState, transitionExpression);
+		set = NodeTransitionSetSemanticAction(compilerState, first);
 	} else{
 		set = transitionExpression->transitionSet;
 		if ( set->identifier!=NULL) {
-			first = SingularExpressionTransitionNodeSemanticAction(transitionExpression);
-			set = NodeTransitionSetSemanticAction(first);
+			first = SingularExpressionTransitionNodeSemanticAction(compilerState, transitionExpression);
+			set = NodeTransitionSetSemanticAction(compilerState, first);
 		}
 	}
-	return TransitionSetDefinitionSemanticAction(identifier,set);
+	return TransitionSetDefinitionSemanticAction(compilerState, identifier,set);
 }
-Definition * SymbolExpressionDefinitionSemanticAction(char * identifier,SymbolExpression * symbolExpression){
+Definition * SymbolExpressionDefinitionSemanticAction(CompilerState * compilerState, char * identifier,SymbolExpression * symbolExpression){
 	SymbolNode * first;
 	SymbolSet * set;
 	if ( symbolExpression->type != SET_EXPRESSION) {
-		first = SingularExpressionSymbolNodeSemanticAction(symbolExpression);
-		set = NodeSymbolSetSemanticAction(first);
+		first = SingularExpressionSymbolNodeSemanticAction(compilerState, symbolExpression);
+		set = NodeSymbolSetSemanticAction(compilerState, first);
 	} else {
 		set = symbolExpression->symbolSet;
 		if ( set->identifier!=NULL ) {
-			first = SingularExpressionSymbolNodeSemanticAction(symbolExpression);
-			set = NodeSymbolSetSemanticAction(first);
+			first = SingularExpressionSymbolNodeSemanticAction(compilerState, symbolExpression);
+			set = NodeSymbolSetSemanticAction(compilerState, first);
 		}
 		
 	}
-	return SymbolSetDefinitionSemanticAction(identifier,set);
+	return SymbolSetDefinitionSemanticAction(compilerState, identifier,set);
 }
 
-Definition * StateExpressionDefinitionSemanticAction(char * identifier,StateExpression * stateExpression){
+Definition * StateExpressionDefinitionSemanticAction(CompilerState * compilerState, char * identifier,StateExpression * stateExpression){
 	StateNode * first;
 	StateSet * set;
 	if ( stateExpression->type != SET_EXPRESSION) {
-		first = SingularExpressionStateNodeSemanticAction(stateExpression);
-		set = NodeStateSetSemanticAction(first);
+		first = SingularExpressionStateNodeSemanticAction(compilerState, stateExpression);
+		set = NodeStateSetSemanticAction(compilerState, first);
 	} else{
 		set = stateExpression->stateSet;
 		if ( set->identifier != NULL) {
-			first = SingularExpressionStateNodeSemanticAction(stateExpression);
-			set = NodeStateSetSemanticAction(first);
+			first = SingularExpressionStateNodeSemanticAction(compilerState, stateExpression);
+			set = NodeStateSetSemanticAction(compilerState, first);
 		}
 	}
-	return StateSetDefinitionSemanticAction(identifier,set);
+	return StateSetDefinitionSemanticAction(compilerState, identifier,set);
 }
 
 
 /* ------------------------------------------------- AUTOMATA ------------------------------------------------- */
 
-Automata * AutomataSemanticAction( StateExpression* states, SymbolExpression* alphabet, TransitionExpression* transitions) {
+Automata * AutomataSemanticAction(CompilerState * compilerState, StateExpression* states, SymbolExpression* alphabet, TransitionExpression* transitions) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Automata * automata = calloc(1, sizeof(Automata));
+	Automata * automata = _allocate(compilerState, sizeof(Automata));
 	automata->states = states;
 	automata->alphabet = alphabet;
 	automata->transitions = transitions;
@@ -181,27 +188,27 @@ Automata * AutomataSemanticAction( StateExpression* states, SymbolExpression* al
 
 /*---------------------------EXPRESIONES QUE REPRESENTAN UNA OPERACIÓN ENTRE CONJUNTOS-------------*/
 
-TransitionExpression * TransitionExpressionSemanticAction(TransitionExpression * leftExpression, TransitionExpression * rightExpression, ExpressionType type) {
+TransitionExpression * TransitionExpressionSemanticAction(CompilerState * compilerState, TransitionExpression * leftExpression, TransitionExpression * rightExpression, ExpressionType type) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	TransitionExpression * expression = calloc(1, sizeof(TransitionExpression));
+	TransitionExpression * expression = _allocate(compilerState, sizeof(TransitionExpression));
 	expression->leftExpression = leftExpression;
 	expression->rightExpression = rightExpression;
 	expression->type = type;
 	return expression;
 }
 
-StateExpression * StateExpressionSemanticAction(StateExpression * leftExpression, StateExpression * rightExpression, ExpressionType type) {
+StateExpression * StateExpressionSemanticAction(CompilerState * compilerState, StateExpression * leftExpression, StateExpression * rightExpression, ExpressionType type) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	StateExpression * expression = calloc(1, sizeof(StateExpression));
+	StateExpression * expression = _allocate(compilerState, sizeof(StateExpression));
 	expression->leftExpression = leftExpression;
 	expression->rightExpression = rightExpression;
 	expression->type = type;
 	return expression;
 }
 
-SymbolExpression * SymbolExpressionSemanticAction(SymbolExpression * leftExpression, SymbolExpression * rightExpression, ExpressionType type) {
+SymbolExpression * SymbolExpressionSemanticAction(CompilerState * compilerState, SymbolExpression * leftExpression, SymbolExpression * rightExpression, ExpressionType type) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	SymbolExpression * expression = calloc(1, sizeof(SymbolExpression));
+	SymbolExpression * expression = _allocate(compilerState, sizeof(SymbolExpression));
 	expression->leftExpression = leftExpression;
 	expression->rightExpression = rightExpression;
 	expression->type = type;
@@ -210,27 +217,27 @@ SymbolExpression * SymbolExpressionSemanticAction(SymbolExpression * leftExpress
 
 /*----------------EXPRESIONES QUE REPRESENTAN UN SUBCONJUNTO DE ELEMENTOS ------------------*/
 //conjunto de transiciones per se (al menos es un subconjunto)
-TransitionExpression * SetTransitionExpressionSemanticAction(TransitionSet * transitionSet){
+TransitionExpression * SetTransitionExpressionSemanticAction(CompilerState * compilerState, TransitionSet * transitionSet){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	TransitionExpression * expression = calloc(1, sizeof(TransitionExpression));
+	TransitionExpression * expression = _allocate(compilerState, sizeof(TransitionExpression));
 	expression->transitionSet = transitionSet;
 	expression->type = SET_EXPRESSION;
 	return expression;
 }
 
 //conjunto de símbolos per se (al menos es un subconjunto)
-SymbolExpression * SetSymbolExpressionSemanticAction(SymbolSet * symbolSet){
+SymbolExpression * SetSymbolExpressionSemanticAction(CompilerState * compilerState, SymbolSet * symbolSet){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	SymbolExpression * expression = calloc(1, sizeof(SymbolExpression));
+	SymbolExpression * expression = _allocate(compilerState, sizeof(SymbolExpression));
 	expression->symbolSet= symbolSet;
 	expression->type = SET_EXPRESSION;
 	return expression;
 }
 
 //conjuto de estados per se (al menos es un subconjunto)
-StateExpression * SetStateExpressionSemanticAction(StateSet * stateSet){
+StateExpression * SetStateExpressionSemanticAction(CompilerState * compilerState, StateSet * stateSet){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	StateExpression * expression = calloc(1, sizeof(StateExpression));
+	StateExpression * expression = _allocate(compilerState, sizeof(StateExpression));
 	expression->stateSet = stateSet;
 	expression->type = SET_EXPRESSION;
 	return expression;
@@ -238,25 +245,25 @@ StateExpression * SetStateExpressionSemanticAction(StateSet * stateSet){
 
 /*---------------------------EXPRESIONES QUE REPRESENTAN UN ELEMENTO SUELTO --------------------*/
 
-TransitionExpression * SingularTransitionExpressionSemanticAction(Transition * transition){
+TransitionExpression * SingularTransitionExpressionSemanticAction(CompilerState * compilerState, Transition * transition){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	TransitionExpression * expression = calloc(1, sizeof(TransitionExpression));
+	TransitionExpression * expression = _allocate(compilerState, sizeof(TransitionExpression));
 	expression->transition = transition;
 	expression->type = ELEMENT_EXPRESSION;
 	return expression;
 }
 
-StateExpression * SingularStateExpressionSemanticAction(State * state){
+StateExpression * SingularStateExpressionSemanticAction(CompilerState * compilerState, State * state){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	StateExpression * expression = calloc(1, sizeof(StateExpression));
+	StateExpression * expression = _allocate(compilerState, sizeof(StateExpression));
 	expression->state = state; 
 	expression->type = ELEMENT_EXPRESSION;
 	return expression;
 }
 
-SymbolExpression* SingularSymbolExpressionSemanticAction(Symbol * symbol){
+SymbolExpression* SingularSymbolExpressionSemanticAction(CompilerState * compilerState, Symbol * symbol){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	SymbolExpression* expression = calloc(1, sizeof(SymbolExpression));
+	SymbolExpression* expression = _allocate(compilerState, sizeof(SymbolExpression));
 	expression->symbol = symbol;
 	expression->type = ELEMENT_EXPRESSION;
 	return expression;
@@ -268,9 +275,9 @@ SymbolExpression* SingularSymbolExpressionSemanticAction(Symbol * symbol){
 
 
 /*----- CONJUNTOS CON AL MENOS UN ELEMENTO (NODO) ------*/
-SymbolSet * NodeSymbolSetSemanticAction(SymbolNode * symbolNode) {
+SymbolSet * NodeSymbolSetSemanticAction(CompilerState * compilerState, SymbolNode * symbolNode) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	SymbolSet * symbolSet = calloc(1, sizeof(SymbolSet));
+	SymbolSet * symbolSet = _allocate(compilerState, sizeof(SymbolSet));
 	symbolSet->first= symbolNode;
 	SymbolNode * finalNode = symbolNode;
 	while (finalNode->next !=NULL){
@@ -280,9 +287,9 @@ SymbolSet * NodeSymbolSetSemanticAction(SymbolNode * symbolNode) {
 	return symbolSet;
 }
 
-StateSet * NodeStateSetSemanticAction(StateNode * stateNode) {
+StateSet * NodeStateSetSemanticAction(CompilerState * compilerState, StateNode * stateNode) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	StateSet * stateSet = calloc(1, sizeof(StateSet));
+	StateSet * stateSet = _allocate(compilerState, sizeof(StateSet));
 	stateSet->first= stateNode;
 	StateNode * finalNode = stateNode;
 	while (finalNode->next !=NULL){
@@ -292,9 +299,9 @@ StateSet * NodeStateSetSemanticAction(StateNode * stateNode) {
 	return stateSet;
 }
 
-TransitionSet * NodeTransitionSetSemanticAction(TransitionNode * transitionNode) {
+TransitionSet * NodeTransitionSetSemanticAction(CompilerState * compilerState, TransitionNode * transitionNode) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	TransitionSet * transitionSet = calloc(1, sizeof(TransitionSet));
+	TransitionSet * transitionSet = _allocate(compilerState, sizeof(TransitionSet));
 	transitionSet->first= transitionNode;
 	TransitionNode * finalNode = transitionNode;
 	while (finalNode->next != NULL){
@@ -305,61 +312,60 @@ TransitionSet * NodeTransitionSetSemanticAction(TransitionNode * transitionNode)
 }
 
 /*----------------- CONJUNTOS VACIOS -------------------*/
-TransitionSet * EmptyTransitionSetSemanticAction(){
+TransitionSet * EmptyTransitionSetSemanticAction(CompilerState * compilerState){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	TransitionSet* emptySet = calloc(1, sizeof(TransitionSet));	
+	TransitionSet* emptySet = _allocate(compilerState, sizeof(TransitionSet));	
 	return emptySet;
 }
 
-StateSet * EmptyStateSetSemanticAction(){
+StateSet * EmptyStateSetSemanticAction(CompilerState * compilerState){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	StateSet * emptySet = calloc(1, sizeof(StateSet));
+	StateSet * emptySet = _allocate(compilerState, sizeof(StateSet));
 	return emptySet;
 }
 
-SymbolSet * EmptySymbolSetSemanticAction(){
+SymbolSet * EmptySymbolSetSemanticAction(CompilerState * compilerState){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	SymbolSet * emptySet = calloc(1, sizeof(SymbolSet));
+	SymbolSet * emptySet = _allocate(compilerState, sizeof(SymbolSet));
 	return emptySet;
 }
 
 /*--------------- CONJUNTO DEFINIDO POR IDENTIFIER-------------------*/
 
-TransitionSet * IdentifierTransitionSetSemanticAction(char * identifier, boolean isFromAutomata){
+TransitionSet * IdentifierTransitionSetSemanticAction(CompilerState * compilerState, char * identifier, boolean isFromAutomata){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	TransitionSet* emptySet = calloc(1, sizeof(TransitionSet));	
+	TransitionSet* emptySet = _allocate(compilerState, sizeof(TransitionSet));	
 	emptySet->isFromAutomata = isFromAutomata;
 	emptySet->identifier = identifier;
 	return emptySet;
 }
 
-StateSet * IdentifierStateSetSemanticAction(char * identifier, boolean isFromAutomata){
+StateSet * IdentifierStateSetSemanticAction(CompilerState * compilerState, char * identifier, boolean isFromAutomata){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	StateSet * emptySet = calloc(1, sizeof(StateSet));
+	StateSet * emptySet = _allocate(compilerState, sizeof(StateSet));
 	emptySet->isFromAutomata = isFromAutomata;
 	emptySet->identifier = identifier;
 	return emptySet;
 }
 
-SymbolSet * IdentifierSymbolSetSemanticAction(char * identifier, boolean isFromAutomata){
+SymbolSet * IdentifierSymbolSetSemanticAction(CompilerState * compilerState, char * identifier, boolean isFromAutomata){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	SymbolSet * emptySet = calloc(1, sizeof(SymbolSet));
+	SymbolSet * emptySet = _allocate(compilerState, sizeof(SymbolSet));
 	emptySet->isFromAutomata = isFromAutomata;
 	emptySet->identifier = identifier;
 	return emptySet;
 }
 
 /*--------------- CONJUNTO A PARTIR DE DOBLE TRANSITION-------------------*/
-TransitionSet * BothSideTransitionSemanticAction(StateExpression *left, StateExpression *right, SymbolExpression *alphabet){
+TransitionSet * BothSideTransitionSemanticAction(CompilerState * compilerState, StateExpression *left, StateExpression *right, SymbolExpression *alphabet){
 	_logSyntacticAnalyzerAction(__FUNCTION__);	
-	Transition * transitionToLeft = LeftTransitionSemanticAction(left,right,alphabet);
-	Transition * transitionToRight = RightTransitionSemanticAction(left,right,alphabet);
-	TransitionExpression * transitionToLeftExpression = SingularTransitionExpressionSemanticAction(transitionToLeft);
-	TransitionExpression * transitionToRightExpression = SingularTransitionExpressionSemanticAction(transitionToRight);
-	TransitionNode * transitionToRightNode = SingularExpressionTransitionNodeSemanticAction(transitionToRightExpression); 
-	TransitionNode * transitionToLeftNode = ExpressionsTransitionNodeSemanticAction(transitionToLeftExpression, transitionToRightNode);
-	
-	TransitionSet * transitionSet = NodeTransitionSetSemanticAction(transitionToLeftNode);
+	Transition * transitionToLeft = LeftTransitionSemanticAction(compilerState, left,right,alphabet);
+	Transition * transitionToRight = RightTransitionSemanticAction(compilerState, left,right,alphabet);
+	TransitionExpression * transitionToLeftExpression = SingularTransitionExpressionSemanticAction(compilerState, transitionToLeft);
+	TransitionExpression * transitionToRightExpression = SingularTransitionExpressionSemanticAction(compilerState, transitionToRight);
+	TransitionNode * transitionToLeftNode = SingularExpressionTransitionNodeSemanticAction(compilerState, transitionToLeftExpression);
+	TransitionSet * transitionSet = NodeTransitionSetSemanticAction(compilerState, transitionToLeftNode);
+	ExpressionsTransitionNodeSemanticAction(compilerState, transitionSet, transitionToRightExpression);
 	transitionSet->isBothSidesTransition = true;
 	return transitionSet;
 }
@@ -368,9 +374,9 @@ TransitionSet * BothSideTransitionSemanticAction(StateExpression *left, StateExp
 
 /*-----------NODOS UNICOS QUE COMPONEN UN CONJUNTO (ÚLTIMO ELEMENTO) ---------------*/
 //formo set a partir de una sola transition expression
-TransitionNode * SingularExpressionTransitionNodeSemanticAction(TransitionExpression * transitionExpression){
+TransitionNode * SingularExpressionTransitionNodeSemanticAction(CompilerState * compilerState, TransitionExpression * transitionExpression){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	TransitionNode * node = calloc(1, sizeof(TransitionNode));
+	TransitionNode * node = _allocate(compilerState, sizeof(TransitionNode));
 	node->transitionExpression = transitionExpression;
 	node->type = EXPRESSION;
 	return node;
@@ -378,64 +384,58 @@ TransitionNode * SingularExpressionTransitionNodeSemanticAction(TransitionExpres
 
 
 //formo set a partir de una sola state expression
-StateNode * SingularExpressionStateNodeSemanticAction(StateExpression * stateExpression){
+StateNode * SingularExpressionStateNodeSemanticAction(CompilerState * compilerState, StateExpression * stateExpression){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	StateNode * node = calloc(1, sizeof(StateNode));
+	StateNode * node = _allocate(compilerState, sizeof(StateNode));
 	node->stateExpression = stateExpression;	
 	node->type = EXPRESSION;
 	return node;
 }
 
 //formo un nodo a partir de una sola symbol expression
-SymbolNode * SingularExpressionSymbolNodeSemanticAction(SymbolExpression * symbolExpression){
+SymbolNode * SingularExpressionSymbolNodeSemanticAction(CompilerState * compilerState, SymbolExpression * symbolExpression){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	SymbolNode * node = calloc(1, sizeof(SymbolNode));
+	SymbolNode * node = _allocate(compilerState, sizeof(SymbolNode));
 	node->symbolExpression = symbolExpression;
 	node->type = EXPRESSION;
 	return node;
 }
 
-/*----------- NODOS INTERMEDIOS QUE CONECTAN CON EL SIGUIENTE ----------------*/
-//formo set con 2 subconjuntos de tipo transition
-TransitionNode * ExpressionsTransitionNodeSemanticAction(TransitionExpression * exp, TransitionNode * nextNode){
+/*----------- NODOS QUE SE AGREGAN AL FINAL DE UN CONJUNTO ----------------*/
+//agrego una transition expression al final del conjunto
+TransitionSet * ExpressionsTransitionNodeSemanticAction(CompilerState * compilerState, TransitionSet * set, TransitionExpression * exp){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	//solo aloco memoria nueva porque necesito el identificador pero los nodos ya están creados
-	TransitionNode * node = calloc(1, sizeof(TransitionNode));	
-	node->transitionExpression= exp;
-	node->type = EXPRESSION;
-	//conecto los nodos con los subconjuntos
-	node->next = nextNode;
-	return node;
+	TransitionNode * node = SingularExpressionTransitionNodeSemanticAction(compilerState, exp);
+	//engancho el nodo en la cola, así no hace falta recorrer la lista
+	set->tail->next = node;
+	set->tail = node;
+	return set;
 }
 
-//formo set con 2 subconjuntos de tipo state
-StateNode * ExpressionsStateNodeSemanticAction(StateExpression* exp, StateNode* nextNode){
+//agrego una state expression al final del conjunto
+StateSet * ExpressionsStateNodeSemanticAction(CompilerState * compilerState, StateSet * set, StateExpression * exp){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	//solo aloco memoria nueva porque necesito el identificador pero los nodos ya están creados
-	StateNode * node = calloc(1, sizeof(StateNode));
-	node->stateExpression= exp;
-	node->type = EXPRESSION;
-	//conecto los nodos con los subconjuntos
-	node->next = nextNode;
-	return node;
+	StateNode * node = SingularExpressionStateNodeSemanticAction(compilerState, exp);
+	//engancho el nodo en la cola, así no hace falta recorrer la lista
+	set->tail->next = node;
+	set->tail = node;
+	return set;
 }
 
-//formo set con 2 subconjuntos de tipo symbol
-SymbolNode * ExpressionsSymbolNodeSemanticAction(SymbolExpression* exp, SymbolNode* nextNode){
+//agrego una symbol expression al final del conjunto
+SymbolSet * ExpressionsSymbolNodeSemanticAction(CompilerState * compilerState, SymbolSet * set, SymbolExpression * exp){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	//solo aloco memoria nueva porque necesito el identificador pero los nodos ya están creados
-	SymbolNode * node = calloc(1, sizeof(SymbolNode));
-	node->symbolExpression = exp;
-	node->type = EXPRESSION;
-	//conecto los nodos 
-	node->next = nextNode;
-	return node;
+	SymbolNode * node = SingularExpressionSymbolNodeSemanticAction(compilerState, exp);
+	//engancho el nodo en la cola, así no hace falta recorrer la lista
+	set->tail->next = node;
+	set->tail = node;
+	return set;
 }
 
 /*-----------------------CONJUNTO DE ESTADOS DE UN AUTOMATA POR TIPO--------------------*/
-StateSet * StateTypeSetSemanticAction(char * identifier, StateType type, boolean isFromAutomata){
+StateSet * StateTypeSetSemanticAction(CompilerState * compilerState, char * identifier, StateType type, boolean isFromAutomata){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	StateSet * stateSet = calloc(1, sizeof(StateSet));
+	StateSet * stateSet = _allocate(compilerState, sizeof(StateSet));
 	stateSet->identifier = identifier;
 	stateSet->isFromAutomata = isFromAutomata;
 	stateSet->stateType = type;
@@ -445,9 +445,9 @@ StateSet * StateTypeSetSemanticAction(char * identifier, StateType type, boolean
 /* ------------------------------------------------- ELEMENTS ------------------------------------------------- */
 
 
-State * StateSemanticAction(boolean isInitial, boolean isFinal, Symbol * symbol){
+State * StateSemanticAction(CompilerState * compilerState, boolean isInitial, boolean isFinal, Symbol * symbol){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	State * state = calloc(1, sizeof(State));
+	State * state = _allocate(compilerState, sizeof(State));
 	state->isFinal = isFinal;
 	state->isInitial = isInitial;
 	state->symbol = *symbol;
@@ -456,34 +456,29 @@ State * StateSemanticAction(boolean isInitial, boolean isFinal, Symbol * symbol)
 
 Symbol * LambdaSemanticAction() {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Symbol * symbol = calloc(1, sizeof(Symbol));
-	symbol->value= LAMBDA_STRING;
-	return symbol;
+	return internSymbol(LAMBDA_STRING);
 }
 
 
-Symbol * SymbolSemanticAction(char * value) {
+Symbol * SymbolSemanticAction(Symbol * symbol) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Symbol * symbol = calloc(1, sizeof(Symbol));
-	symbol->value = strdup(value);
-	//_logger("Value bison:%s",value);
 	return symbol;
 }
 
 // se tiene que mandar un TransitionSet donde ya parseo las transitions en individuales (estado -simbolo-> estado) lo que me sirve para en el 
 // backend hacer el manejo de operaciones con conjuntos de transiciones 
-Transition * LeftTransitionSemanticAction(StateExpression * left, StateExpression * right, SymbolExpression * alphabet){
+Transition * LeftTransitionSemanticAction(CompilerState * compilerState, StateExpression * left, StateExpression * right, SymbolExpression * alphabet){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Transition * transition = calloc(1, sizeof(Transition));	
+	Transition * transition = _allocate(compilerState, sizeof(Transition));	
 	transition->fromExpression= right;
 	transition->toExpression= left;
 	transition->symbolExpression = alphabet;
 	return transition;
 }
 
-Transition * RightTransitionSemanticAction(StateExpression *left, StateExpression *right, SymbolExpression *alphabet){
+Transition * RightTransitionSemanticAction(CompilerState * compilerState, StateExpression *left, StateExpression *right, SymbolExpression *alphabet){
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Transition * transition = calloc(1, sizeof(Transition));
+	Transition * transition = _allocate(compilerState, sizeof(Transition));
 	transition->fromExpression= left;
 	transition->toExpression= right;
 	transition->symbolExpression = alphabet;
@@ -494,11 +489,11 @@ Transition * RightTransitionSemanticAction(StateExpression *left, StateExpressio
 
 Program * ExpressionProgramSemanticAction(CompilerState * compilerState, DefinitionSet* definitionSet) {
 	_logSyntacticAnalyzerAction(__FUNCTION__);
-	Program * program = calloc(1, sizeof(Program));
+	Program * program = _allocate(compilerState, sizeof(Program));
 	program->definitionSet = definitionSet;
 	compilerState->abstractSyntaxtTree = program;
-	if (0 < flexCurrentContext()) {
-		logError(_logger, "The final context is not the default (0): %d", flexCurrentContext());
+	if (0 < flexCurrentContext(compilerState->scanner)) {
+		logError(_logger, "The final context is not the default (0): %d", flexCurrentContext(compilerState->scanner));
 		compilerState->succeed = false;
 	}
 	else {
@@ -5,6 +5,7 @@
 #include "../../shared/Logger.h"
 #include "../../shared/Type.h"
 #include "AbstractSyntaxTree.h"
+#include "SymbolPool.h"
 #include "SyntacticAnalyzer.h"
 #include <stdlib.h>
 
@@ -22,66 +23,62 @@ void shutdownBisonActionsModule();
 
 
 /* Definitions */
-Definition * AutomataDefinitionSemanticAction(AutomataType type, char * identifier, Automata * automata);
-Definition * TransitionSetDefinitionSemanticAction(char * identifier, TransitionSet * set);
-Definition * SymbolSetDefinitionSemanticAction(char * identifier, SymbolSet * set);
-Definition * StateSetDefinitionSemanticAction(char * identifier, StateSet * set);
-DefinitionSet * DefinitionSetSemanticAction(Definition * definition1, DefinitionSet * set2); 
-DefinitionSet * SingularDefinitionSetSemanticAction(Definition * definition);
+Definition * AutomataDefinitionSemanticAction(CompilerState * compilerState, AutomataType type, char * identifier, Automata * automata);
+Definition * TransitionSetDefinitionSemanticAction(CompilerState * compilerState, char * identifier, TransitionSet * set);
+Definition * SymbolSetDefinitionSemanticAction(CompilerState * compilerState, char * identifier, SymbolSet * set);
+Definition * StateSetDefinitionSemanticAction(CompilerState * compilerState, char * identifier, StateSet * set);
+DefinitionSet * DefinitionSetSemanticAction(CompilerState * compilerState, DefinitionSet * set, Definition * definition);
+DefinitionSet * SingularDefinitionSetSemanticAction(CompilerState * compilerState, Definition * definition);
 
-Definition * TransitionExpressionDefinitionSemanticAction(char * identifier,TransitionExpression * transitionExpression);
-Definition * SymbolExpressionDefinitionSemanticAction(char * identifier,SymbolExpression * symbolExpression);
-Definition * StateExpressionDefinitionSemanticAction(char * identifier,StateExpression * stateExpression);
+Definition * TransitionExpressionDefinitionSemanticAction(CompilerState * compilerState, char * identifier,TransitionExpression * transitionExpression);
+Definition * SymbolExpressionDefinitionSemanticAction(CompilerState * compilerState, char * identifier,SymbolExpression * symbolExpression);
+Definition * StateExpressionDefinitionSemanticAction(CompilerState * compilerState, char * identifier,StateExpression * stateExpression);
 
-Automata * AutomataSemanticAction(StateExpression* states, SymbolExpression* alphabet, TransitionExpression* transitions);
+Automata * AutomataSemanticAction(CompilerState * compilerState, StateExpression* states, SymbolExpression* alphabet, TransitionExpression* transitions);
 
-TransitionExpression * TransitionExpressionSemanticAction(TransitionExpression * leftExpression, TransitionExpression * rightExpression, ExpressionType type);
-TransitionExpression * SetTransitionExpressionSemanticAction(TransitionSet * transitionSet);
-TransitionExpression * SingularTransitionExpressionSemanticAction(Transition * transition);
+TransitionExpression * TransitionExpressionSemanticAction(CompilerState * compilerState, TransitionExpression * leftExpression, TransitionExpression * rightExpression, ExpressionType type);
+TransitionExpression * SetTransitionExpressionSemanticAction(CompilerState * compilerState, TransitionSet * transitionSet);
+TransitionExpression * SingularTransitionExpressionSemanticAction(CompilerState * compilerState, Transition * transition);
 
-SymbolExpression * SymbolExpressionSemanticAction(SymbolExpression * leftExpression, SymbolExpression * rightExpression, ExpressionType type);
-SymbolExpression * SetSymbolExpressionSemanticAction(SymbolSet * symbolSet);
-SymbolExpression * SingularSymbolExpressionSemanticAction(Symbol * symbol);
+SymbolExpression * SymbolExpressionSemanticAction(CompilerState * compilerState, SymbolExpression * leftExpression, SymbolExpression * rightExpression, ExpressionType type);
+SymbolExpression * SetSymbolExpressionSemanticAction(CompilerState * compilerState, SymbolSet * symbolSet);
+SymbolExpression * SingularSymbolExpressionSemanticAction(CompilerState * compilerState, Symbol * symbol);
 
-StateExpression * StateExpressionSemanticAction(StateExpression * leftExpression, StateExpression * rightExpression, ExpressionType type);
-StateExpression * SetStateExpressionSemanticAction(StateSet * stateSet);
-StateExpression * SingularStateExpressionSemanticAction(State * state);
+StateExpression * StateExpressionSemanticAction(CompilerState * compilerState, StateExpression * leftExpression, StateExpression * rightExpression, ExpressionType type);
+StateExpression * SetStateExpressionSemanticAction(CompilerState * compilerState, StateSet * stateSet);
+StateExpression * SingularStateExpressionSemanticAction(CompilerState * compilerState, State * state);
 
-TransitionExpression * SetTransitionExpressionSemanticAction(TransitionSet * transitionSet);
-SymbolExpression * SetSymbolExpressionSemanticAction(SymbolSet * symbolSet);
-StateExpression * SetStateExpressionSemanticAction(StateSet * stateSet);
+SymbolSet* IdentifierSymbolSetSemanticAction(CompilerState * compilerState, char * identifier, boolean isFromAutomata);
+StateSet* IdentifierStateSetSemanticAction(CompilerState * compilerState, char * identifier, boolean isFromAutomata);
+TransitionSet* IdentifierTransitionSetSemanticAction(CompilerState * compilerState, char * identifier, boolean isFromAutomata);
 
-SymbolSet* IdentifierSymbolSetSemanticAction(char * identifier, boolean isFromAutomata);
-StateSet* IdentifierStateSetSemanticAction(char * identifier, boolean isFromAutomata);
-TransitionSet* IdentifierTransitionSetSemanticAction(char * identifier, boolean isFromAutomata);
+TransitionNode * SingularExpressionTransitionNodeSemanticAction(CompilerState * compilerState, TransitionExpression * transitionExpression);
+StateNode * SingularExpressionStateNodeSemanticAction(CompilerState * compilerState, StateExpression * stateExpression);
+SymbolNode * SingularExpressionSymbolNodeSemanticAction(CompilerState * compilerState, SymbolExpression * symbolExpression);
 
-TransitionNode * SingularExpressionTransitionNodeSemanticAction(TransitionExpression * transitionExpression);
-StateNode * SingularExpressionStateNodeSemanticAction(StateExpression * stateExpression);
-SymbolNode * SingularExpressionSymbolNodeSemanticAction(SymbolExpression * symbolExpression);
+TransitionSet * ExpressionsTransitionNodeSemanticAction(CompilerState * compilerState, TransitionSet * set, TransitionExpression * expression);
+StateSet * ExpressionsStateNodeSemanticAction(CompilerState * compilerState, StateSet * set, StateExpression * expression);
+SymbolSet * ExpressionsSymbolNodeSemanticAction(CompilerState * compilerState, SymbolSet * set, SymbolExpression * expression);
 
-TransitionNode * ExpressionsTransitionNodeSemanticAction(TransitionExpression * leftExpression, TransitionNode * nextNode);
-StateNode * ExpressionsStateNodeSemanticAction(StateExpression * leftExpression, StateNode * nextNode);
-SymbolNode * ExpressionsSymbolNodeSemanticAction(SymbolExpression * leftExpression, SymbolNode * nextNode);
+TransitionSet * NodeTransitionSetSemanticAction(CompilerState * compilerState, TransitionNode * transitionNode);
+StateSet * NodeStateSetSemanticAction(CompilerState * compilerState, StateNode * stateNode);	
+SymbolSet * NodeSymbolSetSemanticAction(CompilerState * compilerState, SymbolNode * symbolNode);
 
-TransitionSet * NodeTransitionSetSemanticAction(TransitionNode * transitionNode);
-StateSet * NodeStateSetSemanticAction(StateNode * stateNode);	
-SymbolSet * NodeSymbolSetSemanticAction(SymbolNode * symbolNode);
+StateSet * StateTypeSetSemanticAction(CompilerState * compilerState, char * identifier, StateType type, boolean isFromAutomata);
 
-StateSet * StateTypeSetSemanticAction(char * identifier, StateType type, boolean isFromAutomata);
+TransitionSet * EmptyTransitionSetSemanticAction(CompilerState * compilerState);
+StateSet * EmptyStateSetSemanticAction(CompilerState * compilerState);
+SymbolSet * EmptySymbolSetSemanticAction(CompilerState * compilerState);
 
-TransitionSet * EmptyTransitionSetSemanticAction();
-StateSet * EmptyStateSetSemanticAction();
-SymbolSet * EmptySymbolSetSemanticAction();
+TransitionSet * BothSideTransitionSemanticAction(CompilerState * compilerState, StateExpression *leftSet, StateExpression *rightSet, SymbolExpression *alphabet); 
 
-TransitionSet * BothSideTransitionSemanticAction(StateExpression *leftSet, StateExpression *rightSet, SymbolExpression *alphabet); 
+State * StateSemanticAction(CompilerState * compilerState, boolean isInitial, boolean isFinal, Symbol * symbol);
 
-State * StateSemanticAction(boolean isInitial, boolean isFinal, Symbol * symbol);
-
-Transition * LeftTransitionSemanticAction(StateExpression * leftSet, StateExpression * rightSet, SymbolExpression * alphabet);
-Transition * RightTransitionSemanticAction(StateExpression *leftSet, StateExpression *rightSet, SymbolExpression *alphabet);
+Transition * LeftTransitionSemanticAction(CompilerState * compilerState, StateExpression * leftSet, StateExpression * rightSet, SymbolExpression * alphabet);
+Transition * RightTransitionSemanticAction(CompilerState * compilerState, StateExpression *leftSet, StateExpression *rightSet, SymbolExpression *alphabet);
 
 Symbol * LambdaSemanticAction();
-Symbol * SymbolSemanticAction(char * value);
+Symbol * SymbolSemanticAction(Symbol * symbol);
 
 Program * ExpressionProgramSemanticAction(CompilerState * compilerState, DefinitionSet * definitionSet);
 
@@ -2,8 +2,28 @@
 
 #include "BisonActions.h"
 
+/** Lets the parser measure the time spent in the scanner. */
+#define yylex timedYylex
+
 %}
 
+%code requires {
+
+#include "../../shared/CompilerState.h"
+
+}
+
+/**
+ * A pure (reentrant) parser: there are no global variables, so many parsers
+ * can run at the same time. The scanner and the state of the compilation are
+ * passed in every call.
+ *
+ * @see https://www.gnu.org/software/bison/manual/html_node/Pure-Decl.html
+ */
+%define api.pure full
+%lex-param {void * scanner}
+%parse-param {void * scanner} {CompilerState * compilerState}
+
 %define api.value.union.name SemanticValue
 
 %union {
@@ -29,9 +49,6 @@
 	AutomataType automataType;
 	DefinitionSet * definitionSet;
 	StateType stateType;
-	StateNode * stateNode;
-	SymbolNode * symbolNode;
-	TransitionNode * transitionNode;
 }
 
 /**
@@ -57,7 +74,7 @@
 %token <token> CLOSE_BRACE
 %token <token> OPEN_BRACKET
 %token <token> CLOSE_BRACKET
-%token <value> SYMBOL
+%token <symbol> SYMBOL
 %token <token> UNION
 %token <token> DIFFERENCE
 %token <token> INTERSECTION
@@ -101,9 +118,9 @@
 %type <automataType> automataType
 %type <definitionSet> definitionSet
 %type <stateType> stateType
-%type <stateNode> stateNode
-%type <symbolNode> symbolNode
-%type <transitionNode> transitionNode
+%type <stateSet> stateNode
+%type <symbolSet> symbolNode
+%type <transitionSet> transitionNode
 
 /**
  * Precedence and associativity.
@@ -118,20 +135,20 @@
 
 %%
 
-program: definitionSet																			{ $$ = ExpressionProgramSemanticAction(currentCompilerState(), $1); }
+program: definitionSet																			{ $$ = ExpressionProgramSemanticAction(compilerState, $1); }
 	;
 
-definitionSet: definition[left] NEW_LINE definitionSet[right]									{ $$ = DefinitionSetSemanticAction($left, $right); }
-	| definition NEW_LINE																		{ $$ = SingularDefinitionSetSemanticAction($1); }
+definitionSet: definitionSet[left] definition[right] NEW_LINE									{ $$ = DefinitionSetSemanticAction(compilerState, $left, $right); }
+	| definition NEW_LINE																		{ $$ = SingularDefinitionSetSemanticAction(compilerState, $1); }
 	;
 
-definition: automataType[type] IDENTIFIER[identifier] automata[element] 						{ $$ = AutomataDefinitionSemanticAction($type, $identifier, $element); }
-	| TRANSITIONS_KEYWORD IDENTIFIER[identifier] COLON transitionExpression[expression] 				{ $$ = TransitionExpressionDefinitionSemanticAction($identifier, $expression); }
-	| ALPHABET_KEYWORD IDENTIFIER[identifier] COLON symbolExpression[expression] 						{ $$ = SymbolExpressionDefinitionSemanticAction($identifier, $expression); }	
-	| STATES_KEYWORD IDENTIFIER[identifier] COLON stateExpression[expression] 							{ $$ = StateExpressionDefinitionSemanticAction($identifier, $expression); }	
+definition: automataType[type] IDENTIFIER[identifier] automata[element] 						{ $$ = AutomataDefinitionSemanticAction(compilerState, $type, $identifier, $element); }
+	| TRANSITIONS_KEYWORD IDENTIFIER[identifier] COLON transitionExpression[expression] 				{ $$ = TransitionExpressionDefinitionSemanticAction(compilerState, $identifier, $expression); }
+	| ALPHABET_KEYWORD IDENTIFIER[identifier] COLON symbolExpression[expression] 						{ $$ = SymbolExpressionDefinitionSemanticAction(compilerState, $identifier, $expression); }	
+	| STATES_KEYWORD IDENTIFIER[identifier] COLON stateExpression[expression] 							{ $$ = StateExpressionDefinitionSemanticAction(compilerState, $identifier, $expression); }	
 	;		
 	
-automata: OPEN_BRACKET STATES_KEYWORD COLON stateExpression[states] COMMA ALPHABET_KEYWORD COLON symbolExpression[symbols] COMMA TRANSITIONS_KEYWORD COLON transitionExpression[transitions] CLOSE_BRACKET						{ $$ = AutomataSemanticAction($states, $symbols, $transitions); }
+automata: OPEN_BRACKET STATES_KEYWORD COLON stateExpression[states] COMMA ALPHABET_KEYWORD COLON symbolExpression[symbols] COMMA TRANSITIONS_KEYWORD COLON transitionExpression[transitions] CLOSE_BRACKET						{ $$ = AutomataSemanticAction(compilerState, $states, $symbols, $transitions); }
 	;
 
 automataType: DFA																				{ $$ = DFA_AUTOMATA; }
@@ -139,47 +156,47 @@ automataType: DFA																				{ $$ = DFA_AUTOMATA; }
 	| LNFA																						{ $$ = LNFA_AUTOMATA; }
 	;
 
-transitionExpression:  transitionExpression[left] UNION transitionExpression[right] 			{ $$ = TransitionExpressionSemanticAction($left, $right, UNION_EXPRESSION); }
-	| transitionExpression[left] DIFFERENCE transitionExpression[right] 						{ $$ = TransitionExpressionSemanticAction($left, $right, DIFFERENCE_EXPRESSION); }
-	| transitionExpression[left] INTERSECTION transitionExpression[right] 						{ $$ = TransitionExpressionSemanticAction($left, $right, INTERSECTION_EXPRESSION); }																												
-	| transitionSet 																			{ $$ = SetTransitionExpressionSemanticAction($1); }	
-	| transition 																				{ $$ = SingularTransitionExpressionSemanticAction($1); }	
+transitionExpression:  transitionExpression[left] UNION transitionExpression[right] 			{ $$ = TransitionExpressionSemanticAction(compilerState, $left, $right, UNION_EXPRESSION); }
+	| transitionExpression[left] DIFFERENCE transitionExpression[right] 						{ $$ = TransitionExpressionSemanticAction(compilerState, $left, $right, DIFFERENCE_EXPRESSION); }
+	| transitionExpression[left] INTERSECTION transitionExpression[right] 						{ $$ = TransitionExpressionSemanticAction(compilerState, $left, $right, INTERSECTION_EXPRESSION); }																												
+	| transitionSet 																			{ $$ = SetTransitionExpressionSemanticAction(compilerState, $1); }	
+	| transition 																				{ $$ = SingularTransitionExpressionSemanticAction(compilerState, $1); }	
 	| OPEN_PARENTHESIS transitionExpression CLOSE_PARENTHESIS									{ $$ = $2 ;}																														
 	;
 
-stateExpression:  stateExpression[left] UNION stateExpression[right] 							{ $$ = StateExpressionSemanticAction($left, $right, UNION_EXPRESSION); }
-	| stateExpression[left] DIFFERENCE stateExpression[right] 									{ $$ = StateExpressionSemanticAction($left, $right, DIFFERENCE_EXPRESSION); }
-	| stateExpression[left] INTERSECTION stateExpression[right] 								{ $$ = StateExpressionSemanticAction($left, $right, INTERSECTION_EXPRESSION); }
-	| stateSet																					{ $$ = SetStateExpressionSemanticAction($1); }
-	| state																						{ $$ = SingularStateExpressionSemanticAction($1); }	
+stateExpression:  stateExpression[left] UNION stateExpression[right] 							{ $$ = StateExpressionSemanticAction(compilerState, $left, $right, UNION_EXPRESSION); }
+	| stateExpression[left] DIFFERENCE stateExpression[right] 									{ $$ = StateExpressionSemanticAction(compilerState, $left, $right, DIFFERENCE_EXPRESSION); }
+	| stateExpression[left] INTERSECTION stateExpression[right] 								{ $$ = StateExpressionSemanticAction(compilerState, $left, $right, INTERSECTION_EXPRESSION); }
+	| stateSet																					{ $$ = SetStateExpressionSemanticAction(compilerState, $1); }
+	| state																						{ $$ = SingularStateExpressionSemanticAction(compilerState, $1); }	
 	| OPEN_PARENTHESIS stateExpression CLOSE_PARENTHESIS										{ $$ = $2; }
 	;
 
-symbolExpression: symbolExpression[left] UNION symbolExpression[right]							{ $$ = SymbolExpressionSemanticAction($left, $right, UNION_EXPRESSION); }
-	| symbolExpression[left] DIFFERENCE symbolExpression[right]									{ $$ = SymbolExpressionSemanticAction($left, $right, DIFFERENCE_EXPRESSION); }
-	| symbolExpression[left] INTERSECTION symbolExpression[right] 								{ $$ = SymbolExpressionSemanticAction($left, $right, INTERSECTION_EXPRESSION); }
-	| symbolSet 																				{ $$ = SetSymbolExpressionSemanticAction($1); }
-	| symbol																					{ $$ = SingularSymbolExpressionSemanticAction($1); }
+symbolExpression: symbolExpression[left] UNION symbolExpression[right]							{ $$ = SymbolExpressionSemanticAction(compilerState, $left, $right, UNION_EXPRESSION); }
+	| symbolExpression[left] DIFFERENCE symbolExpression[right]									{ $$ = SymbolExpressionSemanticAction(compilerState, $left, $right, DIFFERENCE_EXPRESSION); }
+	| symbolExpression[left] INTERSECTION symbolExpression[right] 								{ $$ = SymbolExpressionSemanticAction(compilerState, $left, $right, INTERSECTION_EXPRESSION); }
+	| symbolSet 																				{ $$ = SetSymbolExpressionSemanticAction(compilerState, $1); }
+	| symbol																					{ $$ = SingularSymbolExpressionSemanticAction(compilerState, $1); }
 	| OPEN_PARENTHESIS symbolExpression CLOSE_PARENTHESIS										{ $$ = $2; }	
 	;
 	
-stateNode: stateExpression															{ $$ = SingularExpressionStateNodeSemanticAction($1); }				
-		| stateExpression COMMA stateNode											{ $$ = ExpressionsStateNodeSemanticAction($1, $3); }
+stateNode: stateExpression															{ $$ = NodeStateSetSemanticAction(compilerState, SingularExpressionStateNodeSemanticAction(compilerState, $1)); }				
+		| stateNode COMMA stateExpression											{ $$ = ExpressionsStateNodeSemanticAction(compilerState, $1, $3); }
 		;
 
-stateSet: OPEN_BRACE stateNode[node] CLOSE_BRACE									{ $$ = NodeStateSetSemanticAction($node); }
-	| EMPTY																			{ $$ = EmptyStateSetSemanticAction();}	
-	| IDENTIFIER																	{ $$ = IdentifierStateSetSemanticAction($1,false); }
-	| IDENTIFIER PERIOD STATES_KEYWORD												{ $$ = IdentifierStateSetSemanticAction($1,true); }	
-	| IDENTIFIER[identifier] PERIOD STATES_KEYWORD PERIOD stateType[typeSet]		{ $$ = StateTypeSetSemanticAction($identifier, $typeSet, true); }	
-	| IDENTIFIER[identifier] PERIOD stateType[typeSet]								{ $$ = StateTypeSetSemanticAction($identifier, $typeSet, false); }	
+stateSet: OPEN_BRACE stateNode[node] CLOSE_BRACE									{ $$ = $node; }
+	| EMPTY																			{ $$ = EmptyStateSetSemanticAction(compilerState);}	
+	| IDENTIFIER																	{ $$ = IdentifierStateSetSemanticAction(compilerState, $1,false); }
+	| IDENTIFIER PERIOD STATES_KEYWORD												{ $$ = IdentifierStateSetSemanticAction(compilerState, $1,true); }	
+	| IDENTIFIER[identifier] PERIOD STATES_KEYWORD PERIOD stateType[typeSet]		{ $$ = StateTypeSetSemanticAction(compilerState, $identifier, $typeSet, true); }	
+	| IDENTIFIER[identifier] PERIOD stateType[typeSet]								{ $$ = StateTypeSetSemanticAction(compilerState, $identifier, $typeSet, false); }	
 	;
 
-state: symbol																{ $$ = StateSemanticAction(false, false, $1); }
-	| FINAL_STATE symbol													{ $$ = StateSemanticAction(false, true, $2); }
-	| INITIAL_STATE	symbol													{ $$ = StateSemanticAction(true, false, $2); }
-	| INITIAL_STATE FINAL_STATE symbol										{ $$ = StateSemanticAction(true, true, $3); }
-	| FINAL_STATE INITIAL_STATE symbol										{ $$ = StateSemanticAction(true, true, $3); }
+state: symbol																{ $$ = StateSemanticAction(compilerState, false, false, $1); }
+	| FINAL_STATE symbol													{ $$ = StateSemanticAction(compilerState, false, true, $2); }
+	| INITIAL_STATE	symbol													{ $$ = StateSemanticAction(compilerState, true, false, $2); }
+	| INITIAL_STATE FINAL_STATE symbol										{ $$ = StateSemanticAction(compilerState, true, true, $3); }
+	| FINAL_STATE INITIAL_STATE symbol										{ $$ = StateSemanticAction(compilerState, true, true, $3); }
 	;
 
 stateType: REGULAR_STATES_KEYWORD											{ $$ = REGULAR; }
@@ -187,29 +204,29 @@ stateType: REGULAR_STATES_KEYWORD											{ $$ = REGULAR; }
 	| FINAL_STATES_KEYWORD													{ $$ = FINAL;}
 	;
 
-transitionNode: transitionExpression										{ $$ = SingularExpressionTransitionNodeSemanticAction($1);}
-	| transitionExpression COMMA transitionNode 							{ $$ = ExpressionsTransitionNodeSemanticAction($1, $3); }
+transitionNode: transitionExpression										{ $$ = NodeTransitionSetSemanticAction(compilerState, SingularExpressionTransitionNodeSemanticAction(compilerState, $1)); }
+	| transitionNode COMMA transitionExpression 							{ $$ = ExpressionsTransitionNodeSemanticAction(compilerState, $1, $3); }
 	;
 
-transitionSet: OPEN_BRACE transitionNode[node] CLOSE_BRACE																						{ $$ = NodeTransitionSetSemanticAction($node);}
-	| EMPTY																																		{ $$ = EmptyTransitionSetSemanticAction();}	
-	| IDENTIFIER																																{ $$ = IdentifierTransitionSetSemanticAction($1, false);}
-	| IDENTIFIER PERIOD TRANSITIONS_KEYWORD																										{ $$ = IdentifierTransitionSetSemanticAction($1, true);}
-	| PIPE stateExpression[left] PIPE END_LEFT_TRANSITION symbolExpression[middle] END_RIGHT_TRANSITION PIPE stateExpression[right] PIPE		{ $$ = BothSideTransitionSemanticAction($left, $right, $middle); }
+transitionSet: OPEN_BRACE transitionNode[node] CLOSE_BRACE																						{ $$ = $node; }
+	| EMPTY																																		{ $$ = EmptyTransitionSetSemanticAction(compilerState);}	
+	| IDENTIFIER																																{ $$ = IdentifierTransitionSetSemanticAction(compilerState, $1, false);}
+	| IDENTIFIER PERIOD TRANSITIONS_KEYWORD																										{ $$ = IdentifierTransitionSetSemanticAction(compilerState, $1, true);}
+	| PIPE stateExpression[left] PIPE END_LEFT_TRANSITION symbolExpression[middle] END_RIGHT_TRANSITION PIPE stateExpression[right] PIPE		{ $$ = BothSideTransitionSemanticAction(compilerState, $left, $right, $middle); }
 	;
 
-transition: PIPE stateExpression[left] PIPE END_LEFT_TRANSITION symbolExpression[middle] BEGIN_LEFT_TRANSITION stateExpression[right] PIPE		{ $$ = LeftTransitionSemanticAction($left, $right, $middle); }
-	| PIPE stateExpression[left] BEGIN_RIGHT_TRANSITION symbolExpression[middle] END_RIGHT_TRANSITION PIPE stateExpression[right] PIPE			{ $$ = RightTransitionSemanticAction($left, $right, $middle); }
+transition: PIPE stateExpression[left] PIPE END_LEFT_TRANSITION symbolExpression[middle] BEGIN_LEFT_TRANSITION stateExpression[right] PIPE		{ $$ = LeftTransitionSemanticAction(compilerState, $left, $right, $middle); }
+	| PIPE stateExpression[left] BEGIN_RIGHT_TRANSITION symbolExpression[middle] END_RIGHT_TRANSITION PIPE stateExpression[right] PIPE			{ $$ = RightTransitionSemanticAction(compilerState, $left, $right, $middle); }
 	;
 
-symbolNode: symbolExpression												{ $$ = SingularExpressionSymbolNodeSemanticAction($1);}
-	| symbolExpression COMMA symbolNode										{ $$ = ExpressionsSymbolNodeSemanticAction($1, $3); }							
+symbolNode: symbolExpression												{ $$ = NodeSymbolSetSemanticAction(compilerState, SingularExpressionSymbolNodeSemanticAction(compilerState, $1)); }
+	| symbolNode COMMA symbolExpression										{ $$ = ExpressionsSymbolNodeSemanticAction(compilerState, $1, $3); }							
 	;
 
-symbolSet: OPEN_BRACE symbolNode[node] CLOSE_BRACE							{ $$ = NodeSymbolSetSemanticAction($node);}
-	| EMPTY																	{ $$ = EmptySymbolSetSemanticAction();}	
-	| IDENTIFIER															{ $$ = IdentifierSymbolSetSemanticAction($1,false); }
-	| IDENTIFIER PERIOD ALPHABET_KEYWORD									{ $$ = IdentifierSymbolSetSemanticAction($1,true); }
+symbolSet: OPEN_BRACE symbolNode[node] CLOSE_BRACE							{ $$ = $node; }
+	| EMPTY																	{ $$ = EmptySymbolSetSemanticAction(compilerState);}	
+	| IDENTIFIER															{ $$ = IdentifierSymbolSetSemanticAction(compilerState, $1,false); }
+	| IDENTIFIER PERIOD ALPHABET_KEYWORD									{ $$ = IdentifierSymbolSetSemanticAction(compilerState, $1,true); }
 	;
 
 symbol: SYMBOL 																{ $$ = SymbolSemanticAction($1); }
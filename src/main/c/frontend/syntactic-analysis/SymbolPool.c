@@ -0,0 +1,62 @@
+#include "SymbolPool.h"
+#include "../../backend/domain-specific/khash.h"
+
+KHASH_MAP_INIT_STR(symbolPool, Symbol *)
+
+/* MODULE INTERNAL STATE */
+
+static Logger * _logger = NULL;
+static khash_t(symbolPool) * _pool = NULL;
+static unsigned int _nextId = 0;
+
+// Parsers may run concurrently, and all of them intern in the same pool.
+static Mutex _mutex = MUTEX_INITIALIZER;
+
+void initializeSymbolPoolModule() {
+	_logger = createLogger("SymbolPool");
+	_pool = kh_init(symbolPool);
+	_nextId = 0;
+}
+
+void shutdownSymbolPoolModule() {
+	if (_pool != NULL) {
+		Symbol * symbol;
+		kh_foreach_value(_pool, symbol, {
+			free(symbol->value);
+			free(symbol);
+		});
+		kh_destroy(symbolPool, _pool);
+		_pool = NULL;
+	}
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PUBLIC FUNCTIONS */
+
+Symbol * internSymbol(const char * lexeme) {
+	lockMutex(&_mutex);
+	khiter_t k = kh_get(symbolPool, _pool, lexeme);
+	if (k != kh_end(_pool)) {
+		Symbol * symbol = kh_value(_pool, k);
+		unlockMutex(&_mutex);
+		return symbol;
+	}
+	Symbol * symbol = calloc(1, sizeof(Symbol));
+	symbol->value = strdup(lexeme);
+	symbol->id = _nextId++;
+	int ret;
+	k = kh_put(symbolPool, _pool, symbol->value, &ret);
+	kh_value(_pool, k) = symbol;
+	unlockMutex(&_mutex);
+	logDebugging(_logger, "Interned symbol \"%s\" with id %u", symbol->value, symbol->id);
+	return symbol;
+}
+
+unsigned int symbolPoolSize() {
+	lockMutex(&_mutex);
+	const unsigned int size = _nextId;
+	unlockMutex(&_mutex);
+	return size;
+}
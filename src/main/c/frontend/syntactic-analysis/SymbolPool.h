@@ -0,0 +1,32 @@
+#ifndef SYMBOL_POOL_HEADER
+#define SYMBOL_POOL_HEADER
+
+#include "../../shared/Concurrency.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include "AbstractSyntaxTree.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** Initialize module's internal state. */
+void initializeSymbolPoolModule();
+
+/** Shutdown module's internal state. */
+void shutdownSymbolPoolModule();
+
+/**
+ * Returns the canonical symbol of a lexeme. Every occurrence of the same
+ * lexeme maps to the same pointer and the same dense identifier (starting at
+ * zero), so symbols can be compared without inspecting their strings. The
+ * symbol is owned by the pool and must not be freed by the client. It's
+ * safe to call it from many threads at once.
+ */
+Symbol * internSymbol(const char * lexeme);
+
+/**
+ * The amount of distinct lexemes interned so far, that is, the upper bound
+ * (exclusive) of every symbol identifier.
+ */
+unsigned int symbolPoolSize();
+
+#endif
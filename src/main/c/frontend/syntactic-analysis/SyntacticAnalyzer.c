@@ -1,11 +1,70 @@
+#include "AbstractSyntaxTree.h"
+#include "BisonParser.h"
 #include "SyntacticAnalyzer.h"
 #include "../lexical-analysis/LexicalAnalyzerContext.h"
 
 /* MODULE INTERNAL STATE */
 
-static CompilerState * _currentCompilerState = NULL;
+/** Chunks smaller than this aren't worth a parse of their own. */
+#define MINIMUM_CHUNK_SIZE (64 * 1024)
+
+/** The amount of chunks per thread, so the work balances between them. */
+#define CHUNKS_PER_THREAD 4
+
+/**
+ * The amount of tokens scanned (and timed) at once, since reading the clocks
+ * costs more than scanning a single token.
+ */
+#define TOKEN_BATCH_SIZE 64
+
+/**
+ * A slice of the input that holds complete definitions, and the result of
+ * its parsing.
+ */
+typedef struct {
+	const char * start;
+	size_t size;
+	unsigned int line;
+	CompilerState compilerState;
+	SyntacticAnalysisStatus status;
+} Chunk;
+
+/**
+ * A token scanned ahead of the parser, and the line of the scanner after it.
+ */
+typedef struct {
+	int token;
+	union SemanticValue semanticValue;
+	unsigned int line;
+} ScannedToken;
+
+/**
+ * The tokens that the scanner already produced, but Bison didn't pull yet.
+ * The scanner never depends on the parser, so it can run ahead of it.
+ */
+typedef struct {
+	ScannedToken tokens[TOKEN_BATCH_SIZE];
+	unsigned int count;
+	unsigned int next;
+	unsigned int line;
+	Timing timing;
+} TokenBatch;
+
+/**
+ * The work shared by the threads of a parallel parse: every thread takes the
+ * next unparsed chunk until there are no more.
+ */
+typedef struct {
+	Chunk * chunks;
+	unsigned int count;
+	atomic_uint next;
+} ChunkQueue;
+
 static Logger * _logger = NULL;
 
+// The batch of the parse that runs in this thread.
+static THREAD_LOCAL TokenBatch _batch;
+
 void initializeSyntacticAnalyzerModule() {
 	_logger = createLogger("SyntacticAnalyzer");
 }
@@ -16,9 +75,12 @@ void shutdownSyntacticAnalyzerModule() {
 	}
 }
 
-/** IMPORTED FUNCTIONS */
+/** Flex exported hooks (see "FlexExport.h"). */
 
-extern LexicalAnalyzerContext * createLexicalAnalyzerContext();
+extern void * flexCreateScanner(LexicalAnalyzerContext * lexicalAnalyzerContext);
+extern void flexDestroyScanner(void * scanner);
+extern boolean flexScanBuffer(void * scanner, char * buffer, const size_t size);
+extern void flexSetLine(void * scanner, const unsigned int line);
 
 /**
  * Bison exported functions.
@@ -31,25 +93,64 @@ extern LexicalAnalyzerContext * createLexicalAnalyzerContext();
  *
  * @see https://www.gnu.org/software/bison/manual/html_node/Parser-Function.html
  */
-extern int yyparse(void);
+extern int yyparse(void * scanner, CompilerState * compilerState);
 
 // Bison error-reporting function.
-void yyerror(const char * string) {
-	LexicalAnalyzerContext * lexicalAnalyzerContext = createLexicalAnalyzerContext();
-	logError(_logger, "Syntax error (on line %d).", lexicalAnalyzerContext->line);
+void yyerror(void * scanner, CompilerState * compilerState, const char * string) {
+	// The scanner may be ahead, so the line is the one of the last token pulled.
+	logError(_logger, "Syntax error (on line %u).", _batch.line);
 }
 
-/* PUBLIC FUNCTIONS */
+/* PRIVATE FUNCTIONS */
 
-CompilerState * currentCompilerState() {
-	return _currentCompilerState;
-}
+static SyntacticAnalysisStatus _parse(CompilerState * compilerState, char * buffer, const size_t size, const unsigned int line);
+static unsigned int _split(const char * buffer, const size_t size, const size_t chunkSize, Chunk * chunks, const unsigned int capacity);
+static void _parseChunk(Chunk * chunk);
+static void _scanBatch(void * scanner);
+static void * _work(void * argument);
 
-SyntacticAnalysisStatus parse(CompilerState * compilerState) {
+/**
+ * Parses with a new scanner, over the standard input if the buffer is NULL
+ * (otherwise, the buffer starts on the specified line). Nothing is shared
+ * between parses, so many of them can run concurrently (as long as each one
+ * has its own compiler state).
+ */
+static SyntacticAnalysisStatus _parse(CompilerState * compilerState, char * buffer, const size_t size, const unsigned int line) {
 	logDebugging(_logger, "Parsing...");
-	_currentCompilerState = compilerState;
-	const int code = yyparse();
-	_currentCompilerState = NULL;
+	LexicalAnalyzerContext * lexicalAnalyzerContext = createLexicalAnalyzerContext(compilerState);
+	void * scanner = flexCreateScanner(lexicalAnalyzerContext);
+	if (scanner == NULL) {
+		logError(_logger, "Cannot create the Flex scanner.");
+		destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
+		compilerState->succeed = false;
+		return OUT_OF_MEMORY;
+	}
+	if (buffer != NULL) {
+		if (!flexScanBuffer(scanner, buffer, size + 2)) {
+			logError(_logger, "Flex rejects the input buffer (it must end with two zero bytes).");
+			flexDestroyScanner(scanner);
+			destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
+			compilerState->succeed = false;
+			return UNKNOWN_ERROR;
+		}
+		flexSetLine(scanner, line);
+	}
+	compilerState->scanner = scanner;
+	_batch.count = 0;
+	_batch.next = 0;
+	_batch.line = line;
+	_batch.timing.wall = 0;
+	_batch.timing.cpu = 0;
+	const Timing start = startTiming();
+	const int code = yyparse(scanner, compilerState);
+	Timing parsing = elapsedTiming(start);
+	parsing.wall -= _batch.timing.wall;
+	parsing.cpu -= _batch.timing.cpu;
+	addPhaseTiming(LEXICAL_ANALYSIS_PHASE, _batch.timing);
+	addPhaseTiming(SYNTACTIC_ANALYSIS_PHASE, parsing);
+	compilerState->scanner = NULL;
+	flexDestroyScanner(scanner);
+	destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
 	SyntacticAnalysisStatus syntacticAnalysisStatus;
 	logDebugging(_logger, "Parsing is done.");
 	switch (code) {
@@ -74,3 +175,203 @@ SyntacticAnalysisStatus parse(CompilerState * compilerState) {
 	compilerState->succeed = false;
 	return syntacticAnalysisStatus;
 }
+
+/**
+ * Splits the buffer after the top-level ";" (those outside comments) that
+ * first exceed the chunk size, so every chunk holds whole definitions. The
+ * last chunk absorbs the trailing text if it has no definition of its own.
+ * It also counts the lines, so every chunk knows the line it starts on.
+ * Returns the amount of chunks.
+ */
+static unsigned int _split(const char * buffer, const size_t size, const size_t chunkSize, Chunk * chunks, const unsigned int capacity) {
+	enum { CODE, INLINE_COMMENT, MULTILINE_COMMENT } context = CODE;
+	unsigned int count = 0;
+	size_t start = 0;
+	size_t lastDelimiter = 0;
+	unsigned int line = 1;
+	unsigned int startLine = 1;
+	for (size_t k = 0; k < size; ++k) {
+		const char character = buffer[k];
+		const char nextCharacter = k + 1 < size ? buffer[k + 1] : '\0';
+		if (character == '\n') {
+			++line;
+		}
+		switch (context) {
+			case CODE:
+				// The skipped character is a "/" or a "*", never a new line.
+				if (character == '/' && nextCharacter == '/') {
+					context = INLINE_COMMENT;
+					++k;
+				}
+				else if (character == '/' && nextCharacter == '*') {
+					context = MULTILINE_COMMENT;
+					++k;
+				}
+				else if (character == ';') {
+					lastDelimiter = k + 1;
+					if (chunkSize <= lastDelimiter - start && count + 1 < capacity) {
+						chunks[count].start = buffer + start;
+						chunks[count].line = startLine;
+						chunks[count++].size = lastDelimiter - start;
+						start = lastDelimiter;
+						startLine = line;
+					}
+				}
+				break;
+			case INLINE_COMMENT:
+				if (character == '\n') {
+					context = CODE;
+				}
+				break;
+			case MULTILINE_COMMENT:
+				if (character == '*' && nextCharacter == '/') {
+					context = CODE;
+					++k;
+				}
+				break;
+		}
+	}
+	if (start < lastDelimiter || count == 0) {
+		chunks[count].start = buffer + start;
+		chunks[count].line = startLine;
+		chunks[count++].size = size - start;
+	}
+	else {
+		chunks[count - 1].size = size - (chunks[count - 1].start - buffer);
+	}
+	return count;
+}
+
+/**
+ * Parses a chunk in a private copy, with its own compiler state and arena.
+ * Flex needs two zero bytes after the chunk, and writes on the buffer while
+ * scanning, but those bytes are the start of the next chunk, which another
+ * thread may be scanning at the same time. The copy is a single "memcpy",
+ * far cheaper than the parse of the chunk.
+ */
+static void _parseChunk(Chunk * chunk) {
+	chunk->compilerState.arena = createArena(ARENA_BLOCK_SIZE);
+	char * buffer = malloc(chunk->size + 2);
+	if (buffer == NULL) {
+		chunk->status = OUT_OF_MEMORY;
+		return;
+	}
+	memcpy(buffer, chunk->start, chunk->size);
+	buffer[chunk->size] = '\0';
+	buffer[chunk->size + 1] = '\0';
+	chunk->status = _parse(&chunk->compilerState, buffer, chunk->size, chunk->line);
+	free(buffer);
+}
+
+/**
+ * Scans the next batch of tokens, in a single measure. It stops after the end
+ * of the input (which the scanner repeats, if Bison asks again).
+ */
+static void _scanBatch(void * scanner) {
+	const Timing start = startTiming();
+	_batch.count = 0;
+	_batch.next = 0;
+	do {
+		ScannedToken * scannedToken = &_batch.tokens[_batch.count++];
+		scannedToken->token = yylex(&scannedToken->semanticValue, scanner);
+		scannedToken->line = currentLexicalAnalyzerContext(scanner)->line;
+	} while (_batch.count < TOKEN_BATCH_SIZE && _batch.tokens[_batch.count - 1].token != 0);
+	const Timing elapsed = elapsedTiming(start);
+	_batch.timing.wall += elapsed.wall;
+	_batch.timing.cpu += elapsed.cpu;
+}
+
+static void * _work(void * argument) {
+	ChunkQueue * queue = argument;
+	for (;;) {
+		const unsigned int k = atomic_fetch_add_explicit(&queue->next, 1, memory_order_relaxed);
+		if (queue->count <= k) {
+			break;
+		}
+		_parseChunk(&queue->chunks[k]);
+	}
+	flushStatisticsCounters();
+	return NULL;
+}
+
+/* PUBLIC FUNCTIONS */
+
+int timedYylex(union SemanticValue * semanticValue, void * scanner) {
+	if (_batch.next == _batch.count) {
+		_scanBatch(scanner);
+	}
+	const ScannedToken * scannedToken = &_batch.tokens[_batch.next++];
+	*semanticValue = scannedToken->semanticValue;
+	_batch.line = scannedToken->line;
+	return scannedToken->token;
+}
+
+SyntacticAnalysisStatus parse(CompilerState * compilerState) {
+	return _parse(compilerState, NULL, 0, 1);
+}
+
+SyntacticAnalysisStatus parseBuffer(CompilerState * compilerState, char * buffer, const size_t size) {
+	return _parse(compilerState, buffer, size, 1);
+}
+
+SyntacticAnalysisStatus parseBufferInParallel(CompilerState * compilerState, char * buffer, const size_t size, const unsigned int threads) {
+	const unsigned int capacity = threads * CHUNKS_PER_THREAD;
+	if (threads < 2 || size < 2 * MINIMUM_CHUNK_SIZE) {
+		return _parse(compilerState, buffer, size, 1);
+	}
+	size_t chunkSize = size / capacity;
+	if (chunkSize < MINIMUM_CHUNK_SIZE) {
+		chunkSize = MINIMUM_CHUNK_SIZE;
+	}
+	ChunkQueue queue = {
+		.chunks = calloc(capacity, sizeof(Chunk)),
+		.count = 0
+	};
+	queue.count = _split(buffer, size, chunkSize, queue.chunks, capacity);
+	atomic_init(&queue.next, 0);
+	if (queue.count == 1) {
+		free(queue.chunks);
+		return _parse(compilerState, buffer, size, 1);
+	}
+	logDebugging(_logger, "Parsing %u chunks with %u threads...", queue.count, threads);
+	const unsigned int workers = threads < queue.count ? threads : queue.count;
+	Thread * threadIds = calloc(workers, sizeof(Thread));
+	unsigned int started = 0;
+	for (; started < workers - 1; ++started) {
+		if (!startThread(&threadIds[started], _work, &queue)) {
+			break;
+		}
+	}
+	// The calling thread also works, so it doesn't sit idle.
+	_work(&queue);
+	for (unsigned int k = 0; k < started; ++k) {
+		joinThread(threadIds[k]);
+	}
+	free(threadIds);
+
+	// Joins the definitions in source order, and adopts the arenas of every chunk.
+	SyntacticAnalysisStatus syntacticAnalysisStatus = ACCEPT;
+	Program * program = NULL;
+	for (unsigned int k = 0; k < queue.count; ++k) {
+		Chunk * chunk = &queue.chunks[k];
+		if (syntacticAnalysisStatus == ACCEPT && chunk->status != ACCEPT) {
+			logError(_logger, "The chunk %u of %u (at line %u) is rejected.", k + 1, queue.count, chunk->line);
+			syntacticAnalysisStatus = chunk->status;
+		}
+		if (syntacticAnalysisStatus == ACCEPT) {
+			Program * chunkProgram = chunk->compilerState.abstractSyntaxtTree;
+			if (program == NULL) {
+				program = chunkProgram;
+			}
+			else {
+				program->definitionSet->tail->next = chunkProgram->definitionSet->first;
+				program->definitionSet->tail = chunkProgram->definitionSet->tail;
+			}
+		}
+		mergeArena(compilerState->arena, chunk->compilerState.arena);
+	}
+	free(queue.chunks);
+	compilerState->abstractSyntaxtTree = program;
+	compilerState->succeed = syntacticAnalysisStatus == ACCEPT;
+	return syntacticAnalysisStatus;
+}
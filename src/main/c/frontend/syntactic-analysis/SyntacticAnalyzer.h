@@ -2,12 +2,25 @@
 #define SYNTACTIC_ANALYZER_HEADER
 
 #include "../../shared/CompilerState.h"
+#include "../../shared/Concurrency.h"
 #include "../../shared/Logger.h"
+#include "../../shared/Statistics.h"
+#include <stdlib.h>
+#include <string.h>
 
-/** Bison imported functions. */
+/** Bison imported functions (the scanner and the parser are reentrant). */
 
-int yylex(void);
-void yyerror(const char * string);
+union SemanticValue;
+
+int yylex(union SemanticValue * semanticValue, void * scanner);
+void yyerror(void * scanner, CompilerState * compilerState, const char * string);
+
+/**
+ * Pulls the next token from Flex, which scans them in batches to measure the
+ * time spent in the lexical-analysis phase. Bison calls it instead of "yylex"
+ * (see the prologue of the grammar).
+ */
+int timedYylex(union SemanticValue * semanticValue, void * scanner);
 
 /** Initialize module's internal state. */
 void initializeSyntacticAnalyzerModule();
@@ -23,15 +36,26 @@ typedef enum {
 } SyntacticAnalysisStatus;
 
 /**
- * Retrieves the current compiler state. The state must be accessed during the
- * parsing phase (i.e., during a call to the "parse" function). Outside of the
- * parse, the state is set to NULL.
+ * Executes the parsing phase of the compiler over the standard input. Every
+ * call uses its own scanner, so it can be called from many threads at once
+ * with different compiler states.
  */
-CompilerState * currentCompilerState();
+SyntacticAnalysisStatus parse(CompilerState * compilerState);
 
 /**
- * Executes the parsing phase of the compiler.
+ * Executes the parsing phase over an in-memory buffer, instead of the
+ * standard input. The buffer must be followed by two zero bytes (which are
+ * not counted in the size), and Flex may write on it while scanning.
  */
-SyntacticAnalysisStatus parse(CompilerState * compilerState);
+SyntacticAnalysisStatus parseBuffer(CompilerState * compilerState, char * buffer, const size_t size);
+
+/**
+ * Analog to "parseBuffer", but splits the buffer in chunks at the top-level
+ * ";" (skipping comments), parses them concurrently in the specified amount
+ * of threads, and joins their definitions in source order. Small buffers are
+ * parsed in a single chunk. Every chunk starts counting on its own line of
+ * the buffer, so errors report the same line as in a sequential parse.
+ */
+SyntacticAnalysisStatus parseBufferInParallel(CompilerState * compilerState, char * buffer, const size_t size, const unsigned int threads);
 
 #endif
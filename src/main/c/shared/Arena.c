@@ -0,0 +1,107 @@
+#include "Arena.h"
+
+/** Every allocation is aligned to the strictest fundamental alignment. */
+#define ARENA_ALIGNMENT 16
+
+struct ArenaBlock {
+	ArenaBlock * previous;
+	size_t size;
+	size_t used;
+};
+
+/* PRIVATE FUNCTIONS */
+
+static size_t _align(const size_t size);
+static ArenaBlock * _createBlock(const size_t size, ArenaBlock * previous);
+static unsigned char * _blockData(ArenaBlock * block);
+
+static size_t _align(const size_t size) {
+	return (size + ARENA_ALIGNMENT - 1) & ~((size_t) ARENA_ALIGNMENT - 1);
+}
+
+/**
+ * Blocks are zero-filled, and memory is never reused, so every allocation is
+ * already zeroed.
+ */
+static ArenaBlock * _createBlock(const size_t size, ArenaBlock * previous) {
+	ArenaBlock * block = calloc(1, _align(sizeof(ArenaBlock)) + size);
+	if (block != NULL) {
+		block->previous = previous;
+		block->size = size;
+	}
+	return block;
+}
+
+static unsigned char * _blockData(ArenaBlock * block) {
+	return (unsigned char *) block + _align(sizeof(ArenaBlock));
+}
+
+/* PUBLIC FUNCTIONS */
+
+Arena * createArena(const size_t blockSize) {
+	Arena * arena = calloc(1, sizeof(Arena));
+	arena->blockSize = _align(blockSize);
+	return arena;
+}
+
+void * allocateFromArena(Arena * arena, const size_t size) {
+	const size_t alignedSize = _align(size);
+	ArenaBlock * block = arena->block;
+	countStatistic(ALLOCATIONS, 1);
+	countStatistic(ALLOCATED_BYTES, alignedSize);
+	if (block == NULL || block->size - block->used < alignedSize) {
+		if (arena->blockSize < 4 * alignedSize) {
+			// Large allocations get their own block, behind the current one.
+			ArenaBlock * largeBlock = _createBlock(alignedSize, block == NULL ? NULL : block->previous);
+			if (largeBlock == NULL) {
+				return NULL;
+			}
+			largeBlock->used = alignedSize;
+			if (block == NULL) {
+				arena->block = largeBlock;
+			}
+			else {
+				block->previous = largeBlock;
+			}
+			return _blockData(largeBlock);
+		}
+		block = _createBlock(arena->blockSize, block);
+		if (block == NULL) {
+			return NULL;
+		}
+		arena->block = block;
+	}
+	void * memory = _blockData(block) + block->used;
+	block->used += alignedSize;
+	return memory;
+}
+
+void mergeArena(Arena * arena, Arena * source) {
+	ArenaBlock * oldest = source->block;
+	if (oldest != NULL) {
+		while (oldest->previous != NULL) {
+			oldest = oldest->previous;
+		}
+		if (arena->block == NULL) {
+			arena->block = source->block;
+		}
+		else {
+			// The adopted blocks go behind the current one, like large blocks.
+			oldest->previous = arena->block->previous;
+			arena->block->previous = source->block;
+		}
+	}
+	free(source);
+}
+
+void destroyArena(Arena * arena) {
+	if (arena != NULL) {
+		ArenaBlock * block = arena->block;
+		while (block != NULL) {
+			ArenaBlock * previous = block->previous;
+			free(block);
+			block = previous;
+		}
+		free(arena);
+	}
+}
@@ -0,0 +1,43 @@
+#ifndef ARENA_HEADER
+#define ARENA_HEADER
+
+#include "Statistics.h"
+#include <stdlib.h>
+
+/** The size of every block the arena requests to the system allocator. */
+#define ARENA_BLOCK_SIZE (64 * 1024)
+
+typedef struct ArenaBlock ArenaBlock;
+
+/**
+ * A bump-pointer allocator. Allocations can't be released one by one: they
+ * all live until the arena is destroyed.
+ */
+typedef struct {
+	ArenaBlock * block;
+	size_t blockSize;
+} Arena;
+
+/**
+ * Creates an empty arena that grows in blocks of the specified size.
+ */
+Arena * createArena(const size_t blockSize);
+
+/**
+ * Reserves zero-filled memory inside the arena, analog to "calloc(1, size)".
+ */
+void * allocateFromArena(Arena * arena, const size_t size);
+
+/**
+ * Moves every allocation of the source arena into the target one (so they
+ * live as long as the target), and releases the source arena. The target
+ * keeps allocating from its current block.
+ */
+void mergeArena(Arena * arena, Arena * source);
+
+/**
+ * Releases every allocation of the arena, and the arena itself.
+ */
+void destroyArena(Arena * arena);
+
+#endif
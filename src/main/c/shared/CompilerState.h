@@ -1,6 +1,7 @@
 #ifndef COMPILER_STATE_HEADER
 #define COMPILER_STATE_HEADER
 
+#include "Arena.h"
 #include "Type.h"
 
 /**
@@ -19,6 +20,12 @@ typedef struct {
 	// The root node of the AST.
 	void * abstractSyntaxtTree;
 
+	// The arena that owns the AST and every structure of the computation.
+	Arena * arena;
+
+	// The (reentrant) Flex scanner of the current parse, or NULL.
+	void * scanner;
+
 	// A flag that indicates the current state of the compilation so far.
 	boolean succeed;
 
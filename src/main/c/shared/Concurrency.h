@@ -0,0 +1,178 @@
+#ifndef CONCURRENCY_HEADER
+#define CONCURRENCY_HEADER
+
+#include "Type.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+/**
+ * The threads, locks and thread-local storage used by the application. With
+ * POSIX threads they wrap "pthread". Builds without them (like Microsoft
+ * Visual Studio, where CMake defines SINGLE_THREADED) get single-threaded
+ * stand-ins: a thread can never be started, so every pool runs its work in
+ * the calling thread, and the locks do nothing.
+ */
+
+#ifndef SINGLE_THREADED
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#define THREAD_LOCAL __thread
+#define MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#define READ_WRITE_LOCK_INITIALIZER PTHREAD_RWLOCK_INITIALIZER
+
+typedef pthread_t Thread;
+typedef pthread_mutex_t Mutex;
+typedef pthread_rwlock_t ReadWriteLock;
+typedef pthread_key_t ThreadKey;
+
+/** Starts a thread that runs the routine. Returns false if it can't. */
+static inline boolean startThread(Thread * thread, void * (* routine)(void *), void * argument) {
+	return pthread_create(thread, NULL, routine, argument) == 0;
+}
+
+static inline void joinThread(Thread thread) {
+	pthread_join(thread, NULL);
+}
+
+static inline void yieldThread() {
+	sched_yield();
+}
+
+static inline void sleepThread(const long nanoseconds) {
+	const struct timespec pause = {
+		.tv_sec = nanoseconds / 1000000000L,
+		.tv_nsec = nanoseconds % 1000000000L
+	};
+	nanosleep(&pause, NULL);
+}
+
+static inline void initializeMutex(Mutex * mutex) {
+	pthread_mutex_init(mutex, NULL);
+}
+
+static inline void destroyMutex(Mutex * mutex) {
+	pthread_mutex_destroy(mutex);
+}
+
+static inline void lockMutex(Mutex * mutex) {
+	pthread_mutex_lock(mutex);
+}
+
+static inline void unlockMutex(Mutex * mutex) {
+	pthread_mutex_unlock(mutex);
+}
+
+static inline void lockForReading(ReadWriteLock * lock) {
+	pthread_rwlock_rdlock(lock);
+}
+
+static inline void lockForWriting(ReadWriteLock * lock) {
+	pthread_rwlock_wrlock(lock);
+}
+
+static inline void unlockReadWriteLock(ReadWriteLock * lock) {
+	pthread_rwlock_unlock(lock);
+}
+
+/**
+ * Creates a key for a value per thread. When a thread ends, the destructor
+ * receives its value (if it isn't NULL).
+ */
+static inline void createThreadKey(ThreadKey * key, void (* destructor)(void *)) {
+	pthread_key_create(key, destructor);
+}
+
+/** Deletes the key, but doesn't call the destructor on the values. */
+static inline void deleteThreadKey(ThreadKey * key) {
+	pthread_key_delete(*key);
+}
+
+static inline void * getThreadValue(ThreadKey * key) {
+	return pthread_getspecific(*key);
+}
+
+static inline void setThreadValue(ThreadKey * key, void * value) {
+	pthread_setspecific(*key, value);
+}
+
+#else
+
+#define THREAD_LOCAL
+#define MUTEX_INITIALIZER 0
+#define READ_WRITE_LOCK_INITIALIZER 0
+
+typedef int Thread;
+typedef int Mutex;
+typedef int ReadWriteLock;
+typedef void * ThreadKey;
+
+static inline boolean startThread(Thread * thread, void * (* routine)(void *), void * argument) {
+	(void) thread;
+	(void) routine;
+	(void) argument;
+	return false;
+}
+
+static inline void joinThread(Thread thread) {
+	(void) thread;
+}
+
+static inline void yieldThread() {
+}
+
+static inline void sleepThread(const long nanoseconds) {
+	(void) nanoseconds;
+}
+
+static inline void initializeMutex(Mutex * mutex) {
+	*mutex = 0;
+}
+
+static inline void destroyMutex(Mutex * mutex) {
+	(void) mutex;
+}
+
+static inline void lockMutex(Mutex * mutex) {
+	(void) mutex;
+}
+
+static inline void unlockMutex(Mutex * mutex) {
+	(void) mutex;
+}
+
+static inline void lockForReading(ReadWriteLock * lock) {
+	(void) lock;
+}
+
+static inline void lockForWriting(ReadWriteLock * lock) {
+	(void) lock;
+}
+
+static inline void unlockReadWriteLock(ReadWriteLock * lock) {
+	(void) lock;
+}
+
+// With a single thread, the key is the value itself.
+static inline void createThreadKey(ThreadKey * key, void (* destructor)(void *)) {
+	(void) destructor;
+	*key = NULL;
+}
+
+static inline void deleteThreadKey(ThreadKey * key) {
+	*key = NULL;
+}
+
+static inline void * getThreadValue(ThreadKey * key) {
+	return *key;
+}
+
+static inline void setThreadValue(ThreadKey * key, void * value) {
+	*key = value;
+}
+
+#endif
+
+#endif
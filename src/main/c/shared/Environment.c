@@ -15,6 +15,19 @@ const boolean getBooleanOrDefault(const char * name, const boolean defaultValue)
 	}
 }
 
+const int getIntegerOrDefault(const char * name, const int defaultValue) {
+	const char * value = getStringOrDefault(name, NULL);
+	if (value == NULL) {
+		return defaultValue;
+	}
+	char * end = NULL;
+	const long number = strtol(value, &end, 10);
+	if (end == value || *end != '\0') {
+		return defaultValue;
+	}
+	return (int) number;
+}
+
 const char * getStringOrDefault(const char * name, const char * defaultValue) {
 	const char * value = getenv(name);
 	if (value == NULL) {
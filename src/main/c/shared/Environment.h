@@ -12,6 +12,13 @@
  */
 const boolean getBooleanOrDefault(const char * name, const boolean defaultValue);
 
+/**
+ * Analog to "getStringOrDefault", but parsing the string as a decimal
+ * integer. The default value is used when the variable is undefined or is
+ * not a number.
+ */
+const int getIntegerOrDefault(const char * name, const int defaultValue);
+
 /**
  * Gets the value of an environment variable by name, or returns a default
  * value if the variable is undefined.
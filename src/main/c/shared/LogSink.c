@@ -0,0 +1,145 @@
+#include "LogSink.h"
+
+/* MODULE INTERNAL STATE */
+
+#define LOG_SINK_MASK (LOG_SINK_CAPACITY - 1)
+
+/**
+ * A slot of the ring-buffer. The sequence tells who owns the slot: a writer
+ * can fill it when the sequence equals its position, and the background
+ * thread can drain it when the sequence equals the position plus one.
+ *
+ * @see https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+typedef struct {
+	atomic_size_t sequence;
+	size_t length;
+	char message[LOG_SINK_MESSAGE_SIZE];
+} LogSlot;
+
+static LogSlot * _slots = NULL;
+static atomic_size_t _writePosition;
+static size_t _readPosition = 0;
+static atomic_bool _running;
+static Thread _thread;
+static boolean _synchronous = false;
+static Mutex _drainMutex = MUTEX_INITIALIZER;
+static FILE * _file = NULL;
+static unsigned int _clients = 0;
+
+/* PRIVATE FUNCTIONS */
+
+static boolean _drain();
+static void * _run(void * argument);
+
+/**
+ * Writes every message available in the ring-buffer. Returns false if there
+ * was nothing to write.
+ */
+static boolean _drain() {
+	boolean drained = false;
+	for (;;) {
+		LogSlot * slot = &_slots[_readPosition & LOG_SINK_MASK];
+		if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != _readPosition + 1) {
+			return drained;
+		}
+		fwrite(slot->message, sizeof(char), slot->length, _file);
+		atomic_store_explicit(&slot->sequence, _readPosition + LOG_SINK_CAPACITY, memory_order_release);
+		++_readPosition;
+		drained = true;
+	}
+}
+
+/**
+ * The background thread: drains the buffer until the sink is closed, and
+ * flushes the file whenever the buffer runs empty.
+ */
+static void * _run(void * argument) {
+	(void) argument;
+	while (atomic_load_explicit(&_running, memory_order_acquire)) {
+		if (!_drain()) {
+			fflush(_file);
+			sleepThread(200000);
+		}
+	}
+	_drain();
+	fflush(_file);
+	return NULL;
+}
+
+/* PUBLIC FUNCTIONS */
+
+boolean openLogSink(const char * path) {
+	if (0 < _clients) {
+		++_clients;
+		return true;
+	}
+	_file = fopen(path, "w");
+	if (_file == NULL) {
+		return false;
+	}
+	_slots = calloc(LOG_SINK_CAPACITY, sizeof(LogSlot));
+	for (size_t k = 0; k < LOG_SINK_CAPACITY; ++k) {
+		atomic_init(&_slots[k].sequence, k);
+	}
+	atomic_init(&_writePosition, 0);
+	atomic_init(&_running, true);
+	_readPosition = 0;
+	// Without a background thread (or without threads at all), every writer
+	// drains the buffer itself.
+	_synchronous = !startThread(&_thread, _run, NULL);
+	_clients = 1;
+	return true;
+}
+
+void closeLogSink() {
+	if (_clients == 0 || 0 < --_clients) {
+		return;
+	}
+	if (!_synchronous) {
+		atomic_store_explicit(&_running, false, memory_order_release);
+		joinThread(_thread);
+	}
+	fclose(_file);
+	_file = NULL;
+	free(_slots);
+	_slots = NULL;
+}
+
+void writeLogSink(const char * context, const char * name, const char * const format, va_list arguments) {
+	size_t position = atomic_load_explicit(&_writePosition, memory_order_relaxed);
+	LogSlot * slot;
+	for (;;) {
+		slot = &_slots[position & LOG_SINK_MASK];
+		const size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+		const intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+		if (difference == 0) {
+			if (atomic_compare_exchange_weak_explicit(&_writePosition, &position, position + 1, memory_order_relaxed, memory_order_relaxed)) {
+				break;
+			}
+		}
+		else {
+			if (difference < 0) {
+				// The buffer is full: let the background thread catch up.
+				yieldThread();
+			}
+			position = atomic_load_explicit(&_writePosition, memory_order_relaxed);
+		}
+	}
+	int length = snprintf(slot->message, LOG_SINK_MESSAGE_SIZE, "%s[%s] ", context, name);
+	if (0 <= length && length < LOG_SINK_MESSAGE_SIZE - 1) {
+		const int messageLength = vsnprintf(slot->message + length, LOG_SINK_MESSAGE_SIZE - 1 - length, format, arguments);
+		length = messageLength < 0 ? length : length + messageLength;
+	}
+	if (length < 0 || LOG_SINK_MESSAGE_SIZE - 1 <= length) {
+		length = LOG_SINK_MESSAGE_SIZE - 2;
+	}
+	slot->message[length] = '\n';
+	slot->length = length + 1;
+	atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+	if (_synchronous) {
+		lockMutex(&_drainMutex);
+		_drain();
+		unlockMutex(&_drainMutex);
+	}
+}
@@ -0,0 +1,39 @@
+#ifndef LOG_SINK_HEADER
+#define LOG_SINK_HEADER
+
+#include "Concurrency.h"
+#include "Type.h"
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/** The amount of messages the ring-buffer can hold (a power of 2). */
+#define LOG_SINK_CAPACITY 4096
+
+/** The maximum length of a message. Longer messages are truncated. */
+#define LOG_SINK_MESSAGE_SIZE 512
+
+/**
+ * Opens the file and starts the background thread that writes on it (or,
+ * if the thread can't be started, writes on it synchronously). Every open
+ * must be balanced with a close: the sink only stops when the last client
+ * closes it.
+ */
+boolean openLogSink(const char * path);
+
+/**
+ * Writes the pending messages and, for the last client, stops the
+ * background thread and closes the file.
+ */
+void closeLogSink();
+
+/**
+ * Formats a message (prefixed with the context and the logger name) into the
+ * ring-buffer. The formatting happens in the calling thread, but the slow
+ * write is left to the background thread. If the buffer is full, waits until
+ * the background thread releases a slot.
+ */
+void writeLogSink(const char * context, const char * name, const char * const format, va_list arguments);
+
+#endif
@@ -6,22 +6,21 @@ static void _log(const Logger * logger, const LoggingLevel loggingLevel, const c
 static LoggingLevel _loggingLevelFromString(const char * loggingLevel);
 static void _logInStream(FILE * const stream, const char * const format, va_list arguments);
 static const char * _toContextString(const LoggingLevel loggingLevel);
+static const char * _toUncoloredContextString(const LoggingLevel loggingLevel);
 
 /**
- * Logs a new message at the specified level, using a format string.
+ * Logs a new message at the specified level, using a format string. The
+ * level was already checked by the caller.
  */
 static void _log(const Logger * logger, const LoggingLevel loggingLevel, const char * const format, va_list arguments) {
-	if (logger->loggingLevel <= loggingLevel) {
-		const char * context = _toContextString(loggingLevel);
-		char * effectiveFormat = concatenate(6, context, "[", logger->name, "] ", format, "\n");
-		if (ERROR <= loggingLevel) {
-			_logInStream(stderr, effectiveFormat, arguments);
-		}
-		else {
-			_logInStream(stdout, effectiveFormat, arguments);
-		}
-		free(effectiveFormat);
+	if (logger->asynchronous) {
+		writeLogSink(_toUncoloredContextString(loggingLevel), logger->name, format, arguments);
+		return;
 	}
+	FILE * const stream = ERROR <= loggingLevel ? stderr : stdout;
+	fprintf(stream, "%s[%s] ", _toContextString(loggingLevel), logger->name);
+	_logInStream(stream, format, arguments);
+	fputc('\n', stream);
 }
 
 /**
@@ -66,6 +65,27 @@ static const char * _toContextString(const LoggingLevel loggingLevel) {
 	}
 }
 
+/**
+ * Get the context string of the specified logging level, without colors (for
+ * files).
+ */
+static const char * _toUncoloredContextString(const LoggingLevel loggingLevel) {
+	switch (loggingLevel) {
+		case ALL:
+			return "[ALL  ]";
+		case DEBUGGING:
+			return "[DEBUG]";
+		case INFORMATION:
+			return "[INFO ]";
+		case WARNING:
+			return "[WARN ]";
+		case ERROR:
+			return "[ERROR]";
+		default:
+			return "[FATAL]";
+	}
+}
+
 /* PUBLIC FUNCTIONS */
 
 Logger * createLogger(char * name) {
@@ -73,6 +93,10 @@ Logger * createLogger(char * name) {
 	logger->loggingLevel = _loggingLevelFromString(getStringOrDefault("LOGGING_LEVEL", "INFORMATION"));
 	logger->name = calloc(1 + strlen(name), sizeof(char));
 	strcpy(logger->name, name);
+	const char * path = getStringOrDefault("LOGGING_FILE", NULL);
+	if (path != NULL) {
+		logger->asynchronous = openLogSink(path);
+	}
 	return logger;
 }
 
@@ -81,41 +105,16 @@ void destroyLogger(Logger * logger) {
 		if (logger->name != NULL) {
 			free(logger->name);
 		}
+		if (logger->asynchronous) {
+			closeLogSink();
+		}
 		free(logger);
 	}
 }
 
-void logCritical(const Logger * logger, const char * const format, ...) {
-	va_list arguments;
-	va_start(arguments, format);
-	_log(logger, CRITICAL, format, arguments);
-	va_end(arguments);
-}
-
-void logDebugging(const Logger * logger, const char * const format, ...) {
-	va_list arguments;
-	va_start(arguments, format);
-	_log(logger, DEBUGGING, format, arguments);
-	va_end(arguments);
-}
-
-void logError(const Logger * logger, const char * const format, ...) {
-	va_list arguments;
-	va_start(arguments, format);
-	_log(logger, ERROR, format, arguments);
-	va_end(arguments);
-}
-
-void logInformation(const Logger * logger, const char * const format, ...) {
-	va_list arguments;
-	va_start(arguments, format);
-	_log(logger, INFORMATION, format, arguments);
-	va_end(arguments);
-}
-
-void logWarning(const Logger * logger, const char * const format, ...) {
+void logMessage(const Logger * logger, const LoggingLevel loggingLevel, const char * const format, ...) {
 	va_list arguments;
 	va_start(arguments, format);
-	_log(logger, WARNING, format, arguments);
+	_log(logger, loggingLevel, format, arguments);
 	va_end(arguments);
 }
@@ -2,6 +2,7 @@
 #define LOGGER_HEADER
 
 #include "Environment.h"
+#include "LogSink.h"
 #include "String.h"
 #include <stdarg.h>
 #include <stdio.h>
@@ -68,11 +69,14 @@ typedef enum {
 
 /**
  * The definition of a logger. It contains a name to see its traces, and a
- * logging level that defines when the logs must be visible.
+ * logging level that defines when the logs must be visible. Asynchronous
+ * loggers write in the file selected by "LOGGING_FILE" through a background
+ * thread, instead of the console.
 */
 typedef struct {
 	LoggingLevel loggingLevel;
 	char * name;
+	boolean asynchronous;
 } Logger;
 
 /**
@@ -86,19 +90,54 @@ Logger * createLogger(char * name);
  */
 void destroyLogger(Logger * logger);
 
+/**
+ * The lowest level that survives compilation. Logs below it are removed by
+ * the compiler (together with their arguments), so a build configured with
+ * "-DMINIMUM_LOGGING_LEVEL=WARNING" pays nothing for DEBUGGING and
+ * INFORMATION traces.
+ */
+#ifndef MINIMUM_LOGGING_LEVEL
+	#define MINIMUM_LOGGING_LEVEL ALL
+#endif
+
+/**
+ * True if a log at the specified level would be visible. Use it to guard
+ * expensive work that only exists to build a log message.
+ */
+#define isLoggingEnabled(logger, level) \
+	(MINIMUM_LOGGING_LEVEL <= (level) && (logger)->loggingLevel <= (level))
+
+/**
+ * Logs at the specified level. The arguments are only evaluated if the log
+ * is visible.
+ */
+#define logAtLevel(logger, level, ...) \
+	do { \
+		const Logger * const _levelLogger = (logger); \
+		if (isLoggingEnabled(_levelLogger, level)) { \
+			logMessage(_levelLogger, level, __VA_ARGS__); \
+		} \
+	} while (0)
+
 /** Logs at CRITICAL level. */
-void logCritical(const Logger * logger, const char * const format, ...);
+#define logCritical(logger, ...) logAtLevel(logger, CRITICAL, __VA_ARGS__)
 
 /** Logs at DEBUGGING level. */
-void logDebugging(const Logger * logger, const char * const format, ...);
+#define logDebugging(logger, ...) logAtLevel(logger, DEBUGGING, __VA_ARGS__)
 
 /** Logs at ERROR level. */
-void logError(const Logger * logger, const char * const format, ...);
+#define logError(logger, ...) logAtLevel(logger, ERROR, __VA_ARGS__)
 
 /** Logs at INFORMATION level. */
-void logInformation(const Logger * logger, const char * const format, ...);
+#define logInformation(logger, ...) logAtLevel(logger, INFORMATION, __VA_ARGS__)
 
 /** Logs at WARNING level. */
-void logWarning(const Logger * logger, const char * const format, ...);
+#define logWarning(logger, ...) logAtLevel(logger, WARNING, __VA_ARGS__)
+
+/**
+ * Logs a message at the specified level, without checking it. Prefer the
+ * macros above, which check the level before evaluating the arguments.
+ */
+void logMessage(const Logger * logger, const LoggingLevel loggingLevel, const char * const format, ...);
 
 #endif
@@ -0,0 +1,116 @@
+#include "MappedFile.h"
+
+/* PRIVATE FUNCTIONS */
+
+static MappedFile * _readFile(FILE * file);
+
+/**
+ * Reads the whole stream into a growable buffer, followed by the two zeroes.
+ */
+static MappedFile * _readFile(FILE * file) {
+	size_t capacity = 64 * 1024;
+	size_t size = 0;
+	char * buffer = malloc(capacity);
+	while (true) {
+		if (capacity < size + 2 + 1) {
+			capacity *= 2;
+			buffer = realloc(buffer, capacity);
+		}
+		const size_t length = fread(buffer + size, sizeof(char), capacity - size - 2, file);
+		size += length;
+		if (length == 0) {
+			break;
+		}
+	}
+	if (ferror(file)) {
+		free(buffer);
+		return NULL;
+	}
+	buffer[size] = '\0';
+	buffer[size + 1] = '\0';
+	MappedFile * mappedFile = calloc(1, sizeof(MappedFile));
+	mappedFile->buffer = buffer;
+	mappedFile->size = size;
+	mappedFile->mappedSize = capacity;
+	mappedFile->mapped = false;
+	return mappedFile;
+}
+
+/* PUBLIC FUNCTIONS */
+
+#if defined(_WIN32)
+
+// Without "mmap", the file is always read.
+MappedFile * mapFile(const char * path) {
+	FILE * file = fopen(path, "rb");
+	if (file == NULL) {
+		return NULL;
+	}
+	MappedFile * mappedFile = _readFile(file);
+	fclose(file);
+	return mappedFile;
+}
+
+#else
+
+MappedFile * mapFile(const char * path) {
+	const int descriptor = open(path, O_RDONLY);
+	if (descriptor < 0) {
+		return NULL;
+	}
+	struct stat status;
+	if (fstat(descriptor, &status) < 0) {
+		close(descriptor);
+		return NULL;
+	}
+	if (!S_ISREG(status.st_mode)) {
+		FILE * file = fdopen(descriptor, "rb");
+		if (file == NULL) {
+			close(descriptor);
+			return NULL;
+		}
+		MappedFile * mappedFile = _readFile(file);
+		fclose(file);
+		return mappedFile;
+	}
+	const size_t size = (size_t) status.st_size;
+	const size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+	const size_t mappedSize = (size + 2 + pageSize - 1) & ~(pageSize - 1);
+
+	// Reserves zero-filled pages for the file and its two trailing zeroes,
+	// then maps the file over them: the bytes past the end of the file are
+	// zero either way.
+	char * buffer = mmap(NULL, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (buffer == MAP_FAILED) {
+		close(descriptor);
+		return NULL;
+	}
+	if (0 < size && mmap(buffer, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, descriptor, 0) == MAP_FAILED) {
+		munmap(buffer, mappedSize);
+		close(descriptor);
+		return NULL;
+	}
+	close(descriptor);
+	MappedFile * mappedFile = calloc(1, sizeof(MappedFile));
+	mappedFile->buffer = buffer;
+	mappedFile->size = size;
+	mappedFile->mappedSize = mappedSize;
+	mappedFile->mapped = true;
+	return mappedFile;
+}
+
+#endif
+
+void unmapFile(MappedFile * mappedFile) {
+	if (mappedFile != NULL) {
+		if (mappedFile->mapped) {
+#if !defined(_WIN32)
+			munmap(mappedFile->buffer, mappedFile->mappedSize);
+#endif
+		}
+		else {
+			free(mappedFile->buffer);
+		}
+		free(mappedFile);
+	}
+}
@@ -0,0 +1,40 @@
+#ifndef MAPPED_FILE_HEADER
+#define MAPPED_FILE_HEADER
+
+#include "Type.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#if !defined(_WIN32)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+/**
+ * A file mapped in memory. The buffer holds the content of the file followed
+ * by two zero bytes, which is the layout Flex expects from "yy_scan_buffer".
+ * The mapping is private: writing on the buffer never changes the file.
+ * Files that can't be mapped (like pipes, or any file on Microsoft Windows)
+ * are read into memory instead, with the same layout.
+ */
+typedef struct {
+	char * buffer;
+	size_t size;
+	size_t mappedSize;
+	boolean mapped;
+} MappedFile;
+
+/**
+ * Maps the file with the specified path, or reads it if it isn't a regular
+ * file. Returns NULL if it can't be opened, mapped or read.
+ */
+MappedFile * mapFile(const char * path);
+
+/**
+ * Unmaps the file and releases its resources.
+ */
+void unmapFile(MappedFile * mappedFile);
+
+#endif
@@ -0,0 +1,72 @@
+#include "OutputBuffer.h"
+
+/* PRIVATE FUNCTIONS */
+
+static void _reserve(OutputBuffer * outputBuffer, const size_t length);
+
+/**
+ * Makes room for the specified amount of characters (plus the zero that
+ * "vsnprintf" writes), flushing first and growing only if that is not enough.
+ */
+static void _reserve(OutputBuffer * outputBuffer, const size_t length) {
+	if (outputBuffer->length + length < outputBuffer->capacity) {
+		return;
+	}
+	flushOutputBuffer(outputBuffer);
+	if (length < outputBuffer->capacity) {
+		return;
+	}
+	while (outputBuffer->capacity <= length) {
+		outputBuffer->capacity *= 2;
+	}
+	outputBuffer->buffer = realloc(outputBuffer->buffer, outputBuffer->capacity);
+}
+
+/* PUBLIC FUNCTIONS */
+
+OutputBuffer * createOutputBuffer(FILE * stream, const size_t capacity) {
+	OutputBuffer * outputBuffer = calloc(1, sizeof(OutputBuffer));
+	outputBuffer->stream = stream;
+	outputBuffer->capacity = capacity == 0 ? 1 : capacity;
+	outputBuffer->buffer = malloc(outputBuffer->capacity);
+	return outputBuffer;
+}
+
+void writeOutputBuffer(OutputBuffer * outputBuffer, const char * string, const size_t length) {
+	_reserve(outputBuffer, length);
+	memcpy(outputBuffer->buffer + outputBuffer->length, string, length);
+	outputBuffer->length += length;
+}
+
+void printOutputBuffer(OutputBuffer * outputBuffer, const char * const format, va_list arguments) {
+	va_list retry;
+	va_copy(retry, arguments);
+	const size_t available = outputBuffer->capacity - outputBuffer->length;
+	const int length = vsnprintf(outputBuffer->buffer + outputBuffer->length, available, format, arguments);
+	if (0 <= length && (size_t) length < available) {
+		outputBuffer->length += length;
+	}
+	else if (0 <= length) {
+		// It didn't fit: the partial string is discarded and formatted again.
+		_reserve(outputBuffer, length);
+		vsnprintf(outputBuffer->buffer + outputBuffer->length, outputBuffer->capacity - outputBuffer->length, format, retry);
+		outputBuffer->length += length;
+	}
+	va_end(retry);
+}
+
+void flushOutputBuffer(OutputBuffer * outputBuffer) {
+	if (0 < outputBuffer->length) {
+		fwrite(outputBuffer->buffer, sizeof(char), outputBuffer->length, outputBuffer->stream);
+		outputBuffer->length = 0;
+	}
+	fflush(outputBuffer->stream);
+}
+
+void destroyOutputBuffer(OutputBuffer * outputBuffer) {
+	if (outputBuffer != NULL) {
+		flushOutputBuffer(outputBuffer);
+		free(outputBuffer->buffer);
+		free(outputBuffer);
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef OUTPUT_BUFFER_HEADER
+#define OUTPUT_BUFFER_HEADER
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** The amount of bytes the buffer holds before it writes them on the stream. */
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+
+/**
+ * An output stream that formats directly into a growable buffer, and writes
+ * it on the underlying stream in large blocks, instead of issuing a write
+ * for every small piece.
+ */
+typedef struct {
+	FILE * stream;
+	char * buffer;
+	size_t length;
+	size_t capacity;
+} OutputBuffer;
+
+/**
+ * Creates an empty buffer over the specified stream, which starts with the
+ * specified capacity.
+ */
+OutputBuffer * createOutputBuffer(FILE * stream, const size_t capacity);
+
+/**
+ * Appends the first "length" characters of the string.
+ */
+void writeOutputBuffer(OutputBuffer * outputBuffer, const char * string, const size_t length);
+
+/**
+ * Appends a formatted string, analog to "vfprintf". A string longer than the
+ * buffer makes it grow, so it is never truncated.
+ */
+void printOutputBuffer(OutputBuffer * outputBuffer, const char * const format, va_list arguments);
+
+/**
+ * Writes the pending content on the stream.
+ */
+void flushOutputBuffer(OutputBuffer * outputBuffer);
+
+/**
+ * Writes the pending content, and releases the buffer (but doesn't close the
+ * stream).
+ */
+void destroyOutputBuffer(OutputBuffer * outputBuffer);
+
+#endif
@@ -0,0 +1,259 @@
+#include "Statistics.h"
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOGDI
+	#include <windows.h>
+#endif
+
+/* MODULE INTERNAL STATE */
+
+typedef struct {
+	char * name;
+	double wall;
+	double cpu;
+} DefinitionTiming;
+
+THREAD_LOCAL unsigned long long statisticsCounters[COUNTER_COUNT] = { 0 };
+
+static Logger * _logger = NULL;
+static boolean _enabled = false;
+static double _phaseWall[PHASE_COUNT] = { 0 };
+static double _phaseCpu[PHASE_COUNT] = { 0 };
+static DefinitionTiming * _definitions = NULL;
+static unsigned int _definitionCount = 0;
+static unsigned int _definitionCapacity = 0;
+static unsigned long long _counters[COUNTER_COUNT] = { 0 };
+
+// The time it takes to measure nothing, subtracted from every measure.
+static Timing _overhead = { 0 };
+
+static void _calibrate();
+
+// Protects the timings and the totals, that are shared by every thread.
+static Mutex _mutex = MUTEX_INITIALIZER;
+
+static const char * const _phaseNames[PHASE_COUNT] = {
+	"lexical-analysis",
+	"syntactic-analysis",
+	"computation",
+	"generation"
+};
+
+static const char * const _counterNames[COUNTER_COUNT] = {
+	"allocations",
+	"allocated-bytes",
+	"unions",
+	"intersections",
+	"differences",
+	"element-comparisons",
+	"index-lookups",
+	"expression-cache-hits"
+};
+
+void initializeStatisticsModule() {
+	_logger = createLogger("Statistics");
+	_enabled = getBooleanOrDefault("STATISTICS", false);
+	if (_enabled) {
+		_calibrate();
+	}
+}
+
+void shutdownStatisticsModule() {
+	for (unsigned int k = 0; k < _definitionCount; ++k) {
+		free(_definitions[k].name);
+	}
+	free(_definitions);
+	_definitions = NULL;
+	_definitionCount = 0;
+	_definitionCapacity = 0;
+	if (_logger != NULL) {
+		destroyLogger(_logger);
+	}
+}
+
+/* PRIVATE FUNCTIONS */
+
+static double _wallTime();
+static double _cpuTime();
+static void _reportInStream(FILE * const stream);
+static void _reportAsJson(FILE * const stream);
+
+#if defined(_WIN32)
+
+static double _wallTime() {
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * The CPU time of the calling thread, from its kernel and user times (in
+ * units of 100 nanoseconds).
+ */
+static double _cpuTime() {
+	FILETIME creation, exit, kernel, user;
+	GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user);
+	const unsigned long long ticks = (((unsigned long long) kernel.dwHighDateTime << 32) | kernel.dwLowDateTime)
+		+ (((unsigned long long) user.dwHighDateTime << 32) | user.dwLowDateTime);
+	return ticks / 1e7;
+}
+
+#else
+
+static double _wallTime() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * The CPU time of the calling thread.
+ */
+static double _cpuTime() {
+	struct timespec now;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+#endif
+
+/**
+ * Measures the mean overhead of a measure (reading the clocks, mainly). It
+ * matters for short measures, like the one of a batch of tokens.
+ */
+static void _calibrate() {
+	const unsigned int tries = 1024;
+	Timing total = { 0 };
+	for (unsigned int k = 0; k < tries; ++k) {
+		const Timing overhead = elapsedTiming(startTiming());
+		total.wall += overhead.wall;
+		total.cpu += overhead.cpu;
+	}
+	_overhead.wall = total.wall / tries;
+	_overhead.cpu = total.cpu / tries;
+}
+
+/**
+ * Prints a human-readable summary of the statistics.
+ */
+static void _reportInStream(FILE * const stream) {
+	fprintf(stream, "Statistics:\n");
+	fprintf(stream, "  %-24s %12s %12s\n", "phase", "wall (ms)", "cpu (ms)");
+	for (unsigned int k = 0; k < PHASE_COUNT; ++k) {
+		fprintf(stream, "  %-24s %12.3f %12.3f\n", _phaseNames[k], 1000.0 * _phaseWall[k], 1000.0 * _phaseCpu[k]);
+	}
+	fprintf(stream, "  %-24s %12s %12s\n", "definition", "wall (ms)", "cpu (ms)");
+	for (unsigned int k = 0; k < _definitionCount; ++k) {
+		fprintf(stream, "  %-24s %12.3f %12.3f\n", _definitions[k].name, 1000.0 * _definitions[k].wall, 1000.0 * _definitions[k].cpu);
+	}
+	fprintf(stream, "  %-24s %12s\n", "counter", "value");
+	for (unsigned int k = 0; k < COUNTER_COUNT; ++k) {
+		fprintf(stream, "  %-24s %12llu\n", _counterNames[k], _counters[k]);
+	}
+}
+
+/**
+ * Prints the statistics as a JSON object. Times are in seconds.
+ */
+static void _reportAsJson(FILE * const stream) {
+	fprintf(stream, "{\n\t\"phases\": {");
+	for (unsigned int k = 0; k < PHASE_COUNT; ++k) {
+		fprintf(stream, "%s\n\t\t\"%s\": { \"wall\": %.9f, \"cpu\": %.9f }", k == 0 ? "" : ",", _phaseNames[k], _phaseWall[k], _phaseCpu[k]);
+	}
+	fprintf(stream, "\n\t},\n\t\"definitions\": [");
+	for (unsigned int k = 0; k < _definitionCount; ++k) {
+		char * name = escape(_definitions[k].name);
+		fprintf(stream, "%s\n\t\t{ \"name\": \"%s\", \"wall\": %.9f, \"cpu\": %.9f }", k == 0 ? "" : ",", name, _definitions[k].wall, _definitions[k].cpu);
+		free(name);
+	}
+	fprintf(stream, "\n\t],\n\t\"counters\": {");
+	for (unsigned int k = 0; k < COUNTER_COUNT; ++k) {
+		fprintf(stream, "%s\n\t\t\"%s\": %llu", k == 0 ? "" : ",", _counterNames[k], _counters[k]);
+	}
+	fprintf(stream, "\n\t}\n}\n");
+}
+
+/* PUBLIC FUNCTIONS */
+
+Timing startTiming() {
+	Timing timing = {
+		.wall = 0,
+		.cpu = 0
+	};
+	if (_enabled) {
+		timing.wall = _wallTime();
+		timing.cpu = _cpuTime();
+	}
+	return timing;
+}
+
+Timing elapsedTiming(const Timing start) {
+	const Timing end = startTiming();
+	const Timing elapsed = {
+		.wall = end.wall - start.wall - _overhead.wall,
+		.cpu = end.cpu - start.cpu - _overhead.cpu
+	};
+	return elapsed;
+}
+
+void addPhaseTiming(const Phase phase, const Timing elapsed) {
+	if (_enabled) {
+		lockMutex(&_mutex);
+		_phaseWall[phase] += elapsed.wall;
+		_phaseCpu[phase] += elapsed.cpu;
+		unlockMutex(&_mutex);
+	}
+}
+
+void accumulatePhaseTiming(const Phase phase, const Timing start) {
+	if (_enabled) {
+		addPhaseTiming(phase, elapsedTiming(start));
+	}
+}
+
+void accumulateDefinitionTiming(const char * name, const Timing start) {
+	if (!_enabled) {
+		return;
+	}
+	const Timing elapsed = elapsedTiming(start);
+	lockMutex(&_mutex);
+	if (_definitionCount == _definitionCapacity) {
+		_definitionCapacity = _definitionCapacity == 0 ? 16 : 2 * _definitionCapacity;
+		_definitions = realloc(_definitions, _definitionCapacity * sizeof(DefinitionTiming));
+	}
+	DefinitionTiming * definition = &_definitions[_definitionCount++];
+	definition->name = calloc(1 + strlen(name), sizeof(char));
+	strcpy(definition->name, name);
+	definition->wall = elapsed.wall;
+	definition->cpu = elapsed.cpu;
+	unlockMutex(&_mutex);
+}
+
+void flushStatisticsCounters() {
+	lockMutex(&_mutex);
+	for (unsigned int k = 0; k < COUNTER_COUNT; ++k) {
+		_counters[k] += statisticsCounters[k];
+		statisticsCounters[k] = 0;
+	}
+	unlockMutex(&_mutex);
+}
+
+void reportStatistics() {
+	if (!_enabled) {
+		return;
+	}
+	flushStatisticsCounters();
+	const char * path = getStringOrDefault("STATISTICS_FILE", NULL);
+	if (path == NULL) {
+		_reportInStream(stderr);
+		return;
+	}
+	FILE * file = fopen(path, "w");
+	if (file == NULL) {
+		logError(_logger, "Cannot write the statistics to \"%s\".", path);
+		return;
+	}
+	_reportAsJson(file);
+	fclose(file);
+}
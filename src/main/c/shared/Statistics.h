@@ -0,0 +1,110 @@
+#ifndef STATISTICS_HEADER
+#define STATISTICS_HEADER
+
+#include "Concurrency.h"
+#include "Environment.h"
+#include "Logger.h"
+#include "String.h"
+#include "Type.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * The phases of the compilation pipeline. The lexical-analysis runs inside
+ * the syntactic-analysis (Bison pulls every token from Flex), but its time is
+ * subtracted, so the syntactic-analysis only counts the parser itself.
+ */
+typedef enum {
+	LEXICAL_ANALYSIS_PHASE = 0,
+	SYNTACTIC_ANALYSIS_PHASE,
+	COMPUTATION_PHASE,
+	GENERATION_PHASE,
+	PHASE_COUNT
+} Phase;
+
+/**
+ * The events counted during the compilation.
+ */
+typedef enum {
+	ALLOCATIONS = 0,
+	ALLOCATED_BYTES,
+	UNION_OPERATIONS,
+	INTERSECTION_OPERATIONS,
+	DIFFERENCE_OPERATIONS,
+	ELEMENT_COMPARISONS,
+	INDEX_LOOKUPS,
+	EXPRESSION_CACHE_HITS,
+	COUNTER_COUNT
+} Counter;
+
+/**
+ * A point in time (or an elapsed time), both in wall-clock and in CPU time
+ * (in seconds). The CPU time is the one of the calling thread, so the times
+ * measured in different threads add up without counting each other.
+ */
+typedef struct {
+	double wall;
+	double cpu;
+} Timing;
+
+/**
+ * The counters of the current thread. They are always incremented (it's
+ * cheaper than asking if the statistics are enabled), but only reported when
+ * they are. Being per-thread, they need no synchronization.
+ */
+extern THREAD_LOCAL unsigned long long statisticsCounters[COUNTER_COUNT];
+
+#define countStatistic(counter, amount) (statisticsCounters[(counter)] += (amount))
+
+/** Initialize module's internal state. */
+void initializeStatisticsModule();
+
+/** Shutdown module's internal state. */
+void shutdownStatisticsModule();
+
+/**
+ * Returns the current point in time, or zeroes if the statistics are
+ * disabled.
+ */
+Timing startTiming();
+
+/**
+ * Returns the time elapsed since the start point, without the overhead of
+ * the measure. Then, a very short measure can be slightly negative, but the
+ * error averages out when many of them are added.
+ */
+Timing elapsedTiming(const Timing start);
+
+/**
+ * Adds an elapsed time to the specified phase.
+ */
+void addPhaseTiming(const Phase phase, const Timing elapsed);
+
+/**
+ * Adds the time elapsed since the start point to the specified phase.
+ */
+void accumulatePhaseTiming(const Phase phase, const Timing start);
+
+/**
+ * Records the time elapsed since the start point as the time it took to
+ * compute the definition with the specified name.
+ */
+void accumulateDefinitionTiming(const char * name, const Timing start);
+
+/**
+ * Adds the counters of the current thread to the totals of the process, and
+ * resets them. Every thread other than the main one must call it before
+ * finishing, or its counts are lost.
+ */
+void flushStatisticsCounters();
+
+/**
+ * Prints the collected statistics in the standard error, or as JSON in the
+ * file selected by the "STATISTICS_FILE" environment variable. Does nothing
+ * if the statistics are disabled.
+ */
+void reportStatistics();
+
+#endif